@@ -47,12 +47,21 @@
 // To enable synthesizable assertions for out-of-bounds checks, compile -DAC_BANK_ARRAY_ASSERT.
 // To enable plain C++ assertions (not synthesized into the RTL) no additional flags required.
 // To disable all asserts (S/W and H/W), compile -DAC_BANK_ARRAY_ASSERT_NOOP.
+//
+// Bulk operations check the bounds once for the whole range:
+//   my_array.fill(0);                        // all elements
+//   my_array.fill(first, n, v);              // elements [first, first+n)
+//   my_array.copy_from(first, src, n);       // from the C array src
+//   my_array.copy_to(first, dst, n);         // to the C array dst
+//   my_array.swap_ranges(first, other, n);   // with the C array other
+// In C simulation they use the std algorithms, for HLS they are plain loops.
 
 
 #ifndef __AC_ARRAY_1D_H
 #define __AC_ARRAY_1D_H
 
 #include <cstddef>
+#include <algorithm>
 #include <ac_assert.h>
 
 #if defined(AC_BANK_ARRAY_ASSERT)
@@ -80,6 +89,51 @@ class ac_array_1D
     AC_A_BANK_ARRAY_ASSERTION(idx < D1);
     return data[idx];
   }
+
+  void fill(const T &v) { fill(0, D1, v); }
+
+  void fill(size_t first, size_t n, const T &v) {
+    AC_A_BANK_ARRAY_ASSERTION(first <= D1 && n <= D1 - first);
+#ifdef __SYNTHESIS__
+    for (size_t i = 0; i < n; i++)
+      data[first + i] = v;
+#else
+    std::fill(data + first, data + first + n, v);
+#endif
+  }
+
+  void copy_from(size_t first, const T *src, size_t n) {
+    AC_A_BANK_ARRAY_ASSERTION(first <= D1 && n <= D1 - first);
+#ifdef __SYNTHESIS__
+    for (size_t i = 0; i < n; i++)
+      data[first + i] = src[i];
+#else
+    std::copy(src, src + n, data + first);
+#endif
+  }
+
+  void copy_to(size_t first, T *dst, size_t n) const {
+    AC_A_BANK_ARRAY_ASSERTION(first <= D1 && n <= D1 - first);
+#ifdef __SYNTHESIS__
+    for (size_t i = 0; i < n; i++)
+      dst[i] = data[first + i];
+#else
+    std::copy(data + first, data + first + n, dst);
+#endif
+  }
+
+  void swap_ranges(size_t first, T *other, size_t n) {
+    AC_A_BANK_ARRAY_ASSERTION(first <= D1 && n <= D1 - first);
+#ifdef __SYNTHESIS__
+    for (size_t i = 0; i < n; i++) {
+      T t = data[first + i];
+      data[first + i] = other[i];
+      other[i] = t;
+    }
+#else
+    std::swap_ranges(data + first, data + first + n, other);
+#endif
+  }
 };
 
 #endif
@@ -41,17 +41,40 @@
 // to access the array are in the specified subrange.
 //
 // This class works in both the Catapult SystemC flow and the C++ flow.
+//
+// Bulk operations check the subrange bounds once and then access the base
+// array directly (idx is relative to the subrange):
+//   sub.fill(v);  sub.fill(first, n, v);
+//   sub.copy_from(src);  sub.copy_from(first, src, n);    // from a C array
+//   sub.copy_to(dst);    sub.copy_to(first, dst, n);      // to a C array
+//   sub.copy_from(other_sub);                             // tile copy (overlap safe)
+//   sub.swap_ranges(other_sub);
+// When the base array is contiguous (C array or ac_array_1D) C simulation
+// uses the std algorithms; otherwise, and for HLS, they are element loops.
 
 #ifndef __AC_ARRAY_SUBRANGE_H
 #define __AC_ARRAY_SUBRANGE_H
 
 #include <cstddef>
+#include <algorithm>
+#include <type_traits>
 #include <ac_assert.h>
 
+#include <ac_array_1D.h>
 #include <ac_wr_mask_array.h>
 
 //==========================================================================
 
+// contiguous storage of a base array, or null
+template <class B>
+inline std::nullptr_t ac_array_subrange_data(B &) { return nullptr; }
+
+template <typename T, size_t D>
+inline T *ac_array_subrange_data(T (&a)[D]) { return a; }
+
+template <typename T, size_t D>
+inline T *ac_array_subrange_data(ac_array_1D<T, D> &a) { return a.data; }
+
 template <class B>
 class ac_array_subrange
 {
@@ -74,6 +97,104 @@ public:
     AC_A_BANK_ARRAY_ASSERTION(idx < size);
     return array[idx + offset];
   }
+
+  typedef typename std::remove_reference<T>::type value_type;
+
+  void fill(const value_type &v) { fill(0, size, v); }
+
+  void fill(size_t first, size_t n, const value_type &v) {
+    check(first, n);
+#ifndef __SYNTHESIS__
+    if (value_type *p = data()) {
+      std::fill(p + first, p + first + n, v);
+      return;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+      array[offset + first + i] = v;
+  }
+
+  void copy_from(const value_type *src) { copy_from(0, src, size); }
+
+  void copy_from(size_t first, const value_type *src, size_t n) {
+    check(first, n);
+#ifndef __SYNTHESIS__
+    if (value_type *p = data()) {
+      std::copy(src, src + n, p + first);
+      return;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+      array[offset + first + i] = src[i];
+  }
+
+  void copy_to(value_type *dst) { copy_to(0, dst, size); }
+
+  void copy_to(size_t first, value_type *dst, size_t n) {
+    check(first, n);
+#ifndef __SYNTHESIS__
+    if (value_type *p = data()) {
+      std::copy(p + first, p + first + n, dst);
+      return;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+      dst[i] = array[offset + first + i];
+  }
+
+  // copy a subrange of the same size (which may overlap this one)
+  template <class B2>
+  void copy_from(ac_array_subrange<B2> &src) {
+    AC_A_BANK_ARRAY_ASSERTION(src.size == size);
+#ifndef __SYNTHESIS__
+    value_type *p = data();
+    const value_type *q = src.data();
+    if (p && q) {
+      if (p <= q || p >= q + size)
+        std::copy(q, q + size, p);
+      else
+        std::copy_backward(q, q + size, p + size);
+      return;
+    }
+#endif
+    if ((const void *)&src.array == (const void *)&array && src.offset < offset) {
+      for (size_t i = size; i > 0; i--)
+        array[offset + i - 1] = src.array[src.offset + i - 1];
+    } else {
+      for (size_t i = 0; i < size; i++)
+        array[offset + i] = src.array[src.offset + i];
+    }
+  }
+
+  // exchange the contents with a subrange of the same size
+  template <class B2>
+  void swap_ranges(ac_array_subrange<B2> &other) {
+    AC_A_BANK_ARRAY_ASSERTION(other.size == size);
+#ifndef __SYNTHESIS__
+    value_type *p = data();
+    value_type *q = other.data();
+    if (p && q) {
+      std::swap_ranges(p, p + size, q);
+      return;
+    }
+#endif
+    for (size_t i = 0; i < size; i++) {
+      value_type t = array[offset + i];
+      array[offset + i] = other.array[other.offset + i];
+      other.array[other.offset + i] = t;
+    }
+  }
+
+  // first element of the subrange when the base array is contiguous, else null
+  value_type *data() {
+    value_type *p = ac_array_subrange_data(array);
+    return p ? p + offset : p;
+  }
+
+private:
+  void check(size_t first, size_t n) const {
+    AC_A_BANK_ARRAY_ASSERTION(first <= size && n <= size - first);
+  }
 };
 
 template <typename T, int Dim1, int SliceWidth, bool use_be_ram>
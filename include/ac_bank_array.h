@@ -77,6 +77,16 @@
 
 // ac_bank_array_base is the base class for banked arrays,
 // and typically is not directly used in user models.
+//
+// HLS sees each bank as a separate member: the banks are split recursively
+// into a0/a1 by the largest power of two. In C simulation (neither
+// __SYNTHESIS__ nor CCS_SCVERIFY defined) they are instead held in one array
+// so indexing takes no branches, with the same element order and interface.
+// Define AC_BANK_ARRAY_TREE to simulate the synthesis layout.
+
+#if !defined(__SYNTHESIS__) && !defined(CCS_SCVERIFY) && !defined(AC_BANK_ARRAY_TREE)
+#define __AC_BANK_ARRAY_FLAT
+#endif
 
 template <typename B, size_t C, size_t I = 0>
 class ac_bank_array_base;
@@ -105,6 +115,80 @@ public:
   const AC &operator[](size_t idx) const { return a; }
 };
 
+#ifdef __AC_BANK_ARRAY_FLAT
+
+// C simulation: the banks are stored in one array and indexed directly
+
+template <typename B, size_t C, size_t I>
+class ac_bank_array_base
+{
+public:
+  B a[C];
+public:
+  B &operator[](size_t idx) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < C);
+    return a[idx];
+  }
+
+  const B &operator[](size_t idx) const {
+    AC_A_BANK_ARRAY_ASSERTION(idx < C);
+    return a[idx];
+  }
+};
+
+// specialization to get index checking of rightmost dimension using ac_array_1D
+template <typename E, size_t D, size_t C, size_t I>
+class ac_bank_array_base<E [D], C, I>
+{
+  public:
+  typedef ac_array_1D<E,D> AC;
+  AC a[C];
+  AC &operator[](size_t idx) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < C);
+    return a[idx];
+  }
+
+  const AC &operator[](size_t idx) const {
+    AC_A_BANK_ARRAY_ASSERTION(idx < C);
+    return a[idx];
+  }
+};
+
+// references (e.g. banks of ac_channel<T>&) cannot form an array: keep the
+// binary tree of the synthesis layout below
+template <typename B, size_t I>
+class ac_bank_array_base<B &, 1, I>
+{
+public:
+  B &a;
+public:
+  B &operator[](size_t idx) { return a; }
+  const B &operator[](size_t idx) const { return a; }
+};
+
+template <typename B, size_t C, size_t I>
+class ac_bank_array_base<B &, C, I>
+{
+  static const size_t W = ac_max_pow2<C-1>::P;
+public:
+  ac_bank_array_base<B &, W  , I> a0;
+  ac_bank_array_base<B &, C-W, I+W> a1;
+public:
+  B &operator[](size_t idx) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < C);
+    size_t aidx = idx & (W-1);
+    return idx&W ? a1[aidx] : a0[aidx];
+  }
+
+  const B &operator[](size_t idx) const {
+    AC_A_BANK_ARRAY_ASSERTION(idx < C);
+    size_t aidx = idx & (W-1);
+    return idx&W ? a1[aidx] : a0[aidx];
+  }
+};
+
+#else
+
 template <typename B, size_t C, size_t I>
 class ac_bank_array_base
 {
@@ -150,6 +234,24 @@ class ac_bank_array_base<E [D], C, I>
 };
 
 
+#endif // __AC_BANK_ARRAY_FLAT
+
+// ac_bank_array_visit(b, f) calls f(idx, bank) for every bank of an array of
+// references (e.g. ac_channel<T>&), in index order. The tree is walked at
+// compile time, so no per-index bank decode is done.
+template <typename B, size_t I, typename F>
+inline void ac_bank_array_visit(ac_bank_array_base<B &, 1, I> &b, const F &f)
+{
+  f(I, b.a);
+}
+
+template <typename B, size_t C, size_t I, typename F>
+inline void ac_bank_array_visit(ac_bank_array_base<B &, C, I> &b, const F &f)
+{
+  ac_bank_array_visit(b.a0, f);
+  ac_bank_array_visit(b.a1, f);
+}
+
 // ac_bank_array_vary<> supports variable number of array dimensions for a banked array
 //
 // T can be any type: for example:  int, int [0x1000], int [0x10][0x1000]
@@ -171,15 +273,118 @@ class ac_bank_array_vary<T, FirstDim> :
 {
 };
 
+// Storage order of ac_bank_array_2D in C simulation. HLS always sees separate banks.
+//  ac_bank_major:    all elements of bank 0, then bank 1, ...  (C array order)
+//  ac_element_major: element 0 of every bank, then element 1, ... so that
+//                    sweeping an address interleaved across the banks (see
+//                    ac_interleave_array.h) walks memory sequentially
+struct ac_bank_major {};
+struct ac_element_major {};
+
 // ac_bank_array_2D supports common 2D array case where FirstDim is the number of banks
 // and SecondDim is the number of elements in each bank.
 // T is typically a simple scalar type, e.g. uint64
 
-template <typename T, size_t FirstDim, size_t SecondDim>
+//
+// read_all_banks/write_all_banks access element idx of every bank at once
+// (one parallel access per bank in HLS, one strided or contiguous copy in C
+// simulation). The overloads taking 'en' only access the banks with en[bank] set.
+
+template <typename T, size_t FirstDim, size_t SecondDim, typename Layout = ac_bank_major>
 class ac_bank_array_2D : public ac_bank_array_base<T [SecondDim], FirstDim>
 {
+  typedef ac_bank_array_base<T [SecondDim], FirstDim> Base;
+public:
+  void read_all_banks(size_t idx, T (&out)[FirstDim]) const {
+    AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+    #pragma hls_unroll yes
+    for (size_t b = 0; b < FirstDim; b++)
+      out[b] = Base::operator[](b)[idx];
+  }
+  void read_all_banks(size_t idx, T (&out)[FirstDim], const bool (&en)[FirstDim]) const {
+    AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+    #pragma hls_unroll yes
+    for (size_t b = 0; b < FirstDim; b++)
+      if (en[b])
+        out[b] = Base::operator[](b)[idx];
+  }
+  void write_all_banks(size_t idx, const T (&in)[FirstDim]) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+    #pragma hls_unroll yes
+    for (size_t b = 0; b < FirstDim; b++)
+      Base::operator[](b)[idx] = in[b];
+  }
+  void write_all_banks(size_t idx, const T (&in)[FirstDim], const bool (&en)[FirstDim]) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+    #pragma hls_unroll yes
+    for (size_t b = 0; b < FirstDim; b++)
+      if (en[b])
+        Base::operator[](b)[idx] = in[b];
+  }
 };
 
+#ifdef __AC_BANK_ARRAY_FLAT
+// element type of a bank: ac_array_1D for array elements, as in ac_bank_array_base
+template <typename T>
+struct ac_bank_array_elem { typedef T type; };
+template <typename E, size_t D>
+struct ac_bank_array_elem<E [D]> { typedef ac_array_1D<E,D> type; };
+
+// element-major storage: mem[bank] is a strided view of one bank
+template <typename T, size_t FirstDim, size_t SecondDim>
+class ac_bank_array_2D<T, FirstDim, SecondDim, ac_element_major>
+{
+public:
+  typedef typename ac_bank_array_elem<T>::type E;
+  E a[SecondDim][FirstDim];
+
+  template <typename R, typename P>
+  class bank_view {
+    P p;
+    size_t bank;
+  public:
+    bank_view(P p_, size_t bank_) : p(p_), bank(bank_) {}
+    R &operator[](size_t idx) const {
+      AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+      return p[idx][bank];
+    }
+  };
+
+  bank_view<E, E (*)[FirstDim]> operator[](size_t bank) {
+    AC_A_BANK_ARRAY_ASSERTION(bank < FirstDim);
+    return bank_view<E, E (*)[FirstDim]>(a, bank);
+  }
+  bank_view<const E, const E (*)[FirstDim]> operator[](size_t bank) const {
+    AC_A_BANK_ARRAY_ASSERTION(bank < FirstDim);
+    return bank_view<const E, const E (*)[FirstDim]>(a, bank);
+  }
+
+  // element idx of every bank is contiguous
+  void read_all_banks(size_t idx, T (&out)[FirstDim]) const {
+    AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+    for (size_t b = 0; b < FirstDim; b++)
+      out[b] = a[idx][b];
+  }
+  void read_all_banks(size_t idx, T (&out)[FirstDim], const bool (&en)[FirstDim]) const {
+    AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+    for (size_t b = 0; b < FirstDim; b++)
+      if (en[b])
+        out[b] = a[idx][b];
+  }
+  void write_all_banks(size_t idx, const T (&in)[FirstDim]) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+    for (size_t b = 0; b < FirstDim; b++)
+      a[idx][b] = in[b];
+  }
+  void write_all_banks(size_t idx, const T (&in)[FirstDim], const bool (&en)[FirstDim]) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < SecondDim);
+    for (size_t b = 0; b < FirstDim; b++)
+      if (en[b])
+        a[idx][b] = in[b];
+  }
+};
+#endif
+
 // ac_bank_array_3D supports common 3D array case where FirstDim and SecondDim determine
 // the number of banks and ThirdDim is the number of elements in each bank.
 // T is typically a simple scalar type, e.g. uint64
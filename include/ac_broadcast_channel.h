@@ -0,0 +1,364 @@
+/**************************************************************************
+ *                                                                        *
+ *  Algorithmic C (tm) Datatypes                                          *
+ *                                                                        *
+ *  Software Version: 2025.4                                              *
+ *                                                                        *
+ *  Release Date    : Thu Dec 11 10:19:28 PST 2025                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 2025.4.1                                            *
+ *                                                                        *
+ *  Copyright 2025 Siemens                                                *
+ *                                                                        *
+ *                                                                        *
+ *                                                                        *
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      *
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   *
+ *  distributed under the License is distributed on an "AS IS" BASIS,     *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              *
+ *  See the License for the specific language governing permissions and   *
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+
+/*
+//  Source:         ac_broadcast_channel.h
+//  Description:    shared-buffer multi-producer/multi-consumer channel (C++ simulation)
+//
+//  ac_broadcast_channel<T,N> is a channel with N consumer ports that stores
+//  every written element once. Each element carries the mask of the ports it
+//  is addressed to and a count of the ports that have not read it yet; each
+//  port keeps its own read cursor. The element is released when the last
+//  addressed port has read it. Any number of threads may write, and each port
+//  may be read from any thread.
+//
+//    ac_broadcast_channel<pkt_t, 4> bc;          // unbounded
+//    ac_broadcast_channel<pkt_t, 4> bc(64);      // at most 64 stored elements
+//
+//    bc.write(p);                     // to all ports    (ac_broadcast_all)
+//    bc.write_mask(p, 0x5);           // to ports 0 and 2 (ac_broadcast_mask)
+//    bc.write_one(p, 3);              // to port 3       (ac_broadcast_one / ac_demux)
+//
+//    pkt_t q = bc.port(2).read();     // blocking
+//    bool ok = bc.port(1).nb_read(q);
+//
+//  Many producers writing one channel read by port 0 replace a polled fan-in
+//  (ac_join). ac_wait_any(ports...) blocks, without spinning, until one of
+//  the given ports has data and returns its position in the argument list:
+//
+//    switch(ac_wait_any(a.port(0), b.port(1))) { ... }
+//
+//  Blocking reads, writes to a full channel and ac_wait_any wait on a
+//  condition variable, or through ac_channel_scheduler::wait() when a
+//  scheduler (e.g. ac::dataflow) is installed on the calling thread.
+*/
+
+#ifndef __AC_BROADCAST_CHANNEL_H
+#define __AC_BROADCAST_CHANNEL_H
+
+#ifndef __cplusplus
+# error C++ is required to include this header file
+#endif
+#if (__cplusplus < 201103L)
+#error Please use C++11 or a later standard for compilation.
+#endif
+
+#include <ac_int.h>
+#include <ac_channel.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#ifdef __AC_NAMESPACE
+namespace __AC_NAMESPACE {
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Class: ac_channel_event
+//   Generation counter with a condition variable; ac_broadcast_channel
+//   notifies attached events on every write
+////////////////////////////////////////////////////////////////////////////////
+class ac_channel_event {
+public:
+  ac_channel_event() : gen(0) {}
+  void notify() {
+    {
+      std::lock_guard<std::mutex> lk(m);
+      ++gen;
+    }
+    cv.notify_all();
+  }
+  unsigned long long generation() {
+    std::lock_guard<std::mutex> lk(m);
+    return gen;
+  }
+  // wait until notify() has been called after generation() returned g
+  void wait_change(unsigned long long g) {
+    std::unique_lock<std::mutex> lk(m);
+    cv.wait(lk, [&]() { return gen != g; });
+  }
+private:
+  std::mutex m;
+  std::condition_variable cv;
+  unsigned long long gen;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Class: ac_broadcast_channel
+////////////////////////////////////////////////////////////////////////////////
+template<class T, int N>
+class ac_broadcast_channel {
+  static_assert(N >= 1, "ac_broadcast_channel: at least one port");
+public:
+  typedef T element_type;
+  typedef ac_int<N,false> mask_t;
+
+  class port_t {
+  public:
+    T read() { return ch->read(idx); }
+    void read(T &t) { t = ch->read(idx); }
+    bool nb_read(T &t) { return ch->nb_read(idx, t); }
+    T peek() { return ch->peek(idx); }
+    bool available(unsigned int k) { return ch->available(idx, k); }
+    unsigned int size() { return ch->size(idx); }
+    bool empty() { return !available(1); }
+    ac_broadcast_channel &channel() const { return *ch; }
+  private:
+    friend class ac_broadcast_channel;
+    port_t() : ch(0), idx(0) {}
+    ac_broadcast_channel *ch;
+    int idx;
+  };
+
+  explicit ac_broadcast_channel(unsigned int depth = 0) : bound(depth), base(0) {
+    for (int i=0; i<N; i++) {
+      cursor[i] = 0;
+      ports[i].ch = this;
+      ports[i].idx = i;
+    }
+  }
+
+  port_t &port(int i) { return ports[i]; }
+
+  // producer side
+  void write(const T &t) { write_mask(t, all()); }
+  void write_one(const T &t, int i) { mask_t m = 0; m[i] = 1; write_mask(t, m); }
+  void write_mask(const T &t, const mask_t &mask) {
+    if (!mask)
+      return;
+    {
+      std::unique_lock<std::mutex> lk(m);
+      while (bound && q.size() >= bound)
+        block(lk, true);
+      q.push_back(elem(t, mask));
+    }
+    notify();
+  }
+  bool nb_write(const T &t) { return nb_write_mask(t, all()); }
+  bool nb_write_mask(const T &t, const mask_t &mask) {
+    {
+      std::lock_guard<std::mutex> lk(m);
+      if (bound && q.size() >= bound)
+        return false;
+      if (mask)
+        q.push_back(elem(t, mask));
+    }
+    notify();
+    return true;
+  }
+
+  // elements stored (each once, whatever the number of ports it is addressed to)
+  unsigned int stored() {
+    std::lock_guard<std::mutex> lk(m);
+    return q.size();
+  }
+
+  // consumer side, by port index
+  T read(int i) {
+    std::unique_lock<std::mutex> lk(m);
+    unsigned long long p;
+    while (!next(i, p))
+      block(lk, false);
+    T t = q[p - base].data;
+    consume(i, p);
+    lk.unlock();
+    if (bound)
+      notify();
+    return t;
+  }
+  bool nb_read(int i, T &t) {
+    std::unique_lock<std::mutex> lk(m);
+    unsigned long long p;
+    if (!next(i, p))
+      return false;
+    t = q[p - base].data;
+    consume(i, p);
+    lk.unlock();
+    if (bound)
+      notify();
+    return true;
+  }
+  T peek(int i) {
+    std::unique_lock<std::mutex> lk(m);
+    unsigned long long p;
+    while (!next(i, p))
+      block(lk, false);
+    return q[p - base].data;
+  }
+  bool available(int i, unsigned int k) { return size(i) >= k; }
+  unsigned int size(int i) {
+    std::lock_guard<std::mutex> lk(m);
+    unsigned int n = 0;
+    for (unsigned long long p = cursor[i]; p < base + q.size(); p++)
+      n += q[p - base].mask[i];
+    return n;
+  }
+
+  // external events notified on every write/read (used by ac_wait_any)
+  void attach(ac_channel_event *e) {
+    std::lock_guard<std::mutex> lk(m);
+    listeners.push_back(e);
+  }
+  void detach(ac_channel_event *e) {
+    std::lock_guard<std::mutex> lk(m);
+    for (unsigned i=0; i<listeners.size(); i++)
+      if (listeners[i] == e) {
+        listeners.erase(listeners.begin() + i);
+        break;
+      }
+  }
+
+private:
+  static mask_t all() { mask_t a = 0; return ~a; }
+
+  struct elem {
+    T data;
+    mask_t mask;
+    int refs;    // ports that have not read it yet
+    elem(const T &t, const mask_t &m_) : data(t), mask(m_), refs(0) {
+      for (int i=0; i<N; i++)
+        refs += m_[i];
+    }
+  };
+
+  // with m held: position of the next element addressed to port i, skipping
+  // (for good) the elements that are not
+  bool next(int i, unsigned long long &p) {
+    unsigned long long c = cursor[i] < base ? base : cursor[i];
+    while (c < base + q.size() && !q[c - base].mask[i])
+      c++;
+    cursor[i] = c;
+    p = c;
+    return c < base + q.size();
+  }
+  void consume(int i, unsigned long long p) {
+    q[p - base].refs--;
+    cursor[i] = p + 1;
+    while (!q.empty() && !q.front().refs) {
+      q.pop_front();
+      base++;
+    }
+  }
+
+  void block(std::unique_lock<std::mutex> &lk, bool for_write) {
+#ifdef __AC_CHANNEL_RING
+    if (ac_channel_scheduler *sch = ac_channel_scheduler::current()) {
+      lk.unlock();
+      sch->wait(for_write);
+      lk.lock();
+      return;
+    }
+#endif
+    (void)for_write;
+    cv.wait(lk);
+  }
+  void notify() {
+    std::vector<ac_channel_event*> l;
+    {
+      std::lock_guard<std::mutex> lk(m);
+      l = listeners;
+    }
+    cv.notify_all();
+    for (unsigned i=0; i<l.size(); i++)
+      l[i]->notify();
+#ifdef __AC_CHANNEL_RING
+    if (ac_channel_scheduler *sch = ac_channel_scheduler::current())
+      sch->notify();
+#endif
+  }
+
+  std::mutex m;
+  std::condition_variable cv;
+  std::deque<elem> q;
+  unsigned int bound;
+  unsigned long long base;       // absolute position of q.front()
+  unsigned long long cursor[N];  // absolute read position of every port
+  port_t ports[N];
+  std::vector<ac_channel_event*> listeners;
+
+  ac_broadcast_channel(const ac_broadcast_channel &);
+  ac_broadcast_channel &operator=(const ac_broadcast_channel &);
+};
+
+namespace ac_private {
+  inline int wait_any_ready(int) { return -1; }
+  template<typename P0, typename... P>
+  int wait_any_ready(int i, P0 &p0, P &...p) { return p0.available(1) ? i : wait_any_ready(i+1, p...); }
+
+  inline void wait_any_attach(ac_channel_event *, bool) {}
+  template<typename P0, typename... P>
+  void wait_any_attach(ac_channel_event *e, bool on, P0 &p0, P &...p) {
+    if (on)
+      p0.channel().attach(e);
+    else
+      p0.channel().detach(e);
+    wait_any_attach(e, on, p...);
+  }
+}
+
+// Block until one of the ports has data, return its argument position
+template<typename... P>
+int ac_wait_any(P &...ports) {
+  int i = ac_private::wait_any_ready(0, ports...);
+  if (i >= 0)
+    return i;
+  ac_channel_event e;
+  ac_private::wait_any_attach(&e, true, ports...);
+  try {
+    for (;;) {
+      const unsigned long long gen = e.generation();
+      i = ac_private::wait_any_ready(0, ports...);
+      if (i >= 0)
+        break;
+#ifdef __AC_CHANNEL_RING
+      if (ac_channel_scheduler *sch = ac_channel_scheduler::current()) {
+        sch->wait(false);
+        continue;
+      }
+#endif
+      e.wait_change(gen);
+    }
+  } catch (...) {
+    ac_private::wait_any_attach(&e, false, ports...);
+    throw;
+  }
+  ac_private::wait_any_attach(&e, false, ports...);
+  return i;
+}
+
+#ifdef __AC_NAMESPACE
+}
+#endif
+
+#endif // __AC_BROADCAST_CHANNEL_H
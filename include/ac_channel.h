@@ -45,7 +45,10 @@
 #endif
 
 #include <iostream>
+#include <iomanip>
+#include <string>
 #include <deque>
+#include <algorithm>
 
 #if !defined(AC_USER_DEFINED_ASSERT) && !defined(AC_ASSERT_THROW_EXCEPTION)
 # include <assert.h>
@@ -59,6 +62,29 @@
 #include <ac_stacktrace.h>
 #endif
 
+// -DAC_CHANNEL_STATIC_FIFO binds every channel to the inline deque backend at
+//   compile time (no backend pointer test). SystemC/Connections binding and the
+//   ring backend are then not available
+#if defined(AC_CHANNEL_STATIC_FIFO) && (defined(SYSTEMC_INCLUDED) || defined(__CONNECTIONS__CONNECTIONS_H__) || defined(AC_CHANNEL_RING_DEPTH))
+#error "AC_CHANNEL_STATIC_FIFO cannot be combined with SystemC/Connections channels or AC_CHANNEL_RING_DEPTH"
+#endif
+
+// Lock-free single-producer/single-consumer ring backend (C++11 simulation only)
+//   ac_channel<T>::use_ring_buffer(depth) switches one channel to it
+//   -DAC_CHANNEL_RING_DEPTH=<depth> makes it the default backend of every channel
+#if __cplusplus > 199711L && !defined(__SYNTHESIS__) && !defined(AC_CHANNEL_STATIC_FIFO)
+#define __AC_CHANNEL_RING
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// Counting backend for channels whose elements carry no data (used by ac_sync)
+#if !defined(__SYNTHESIS__) && !defined(CCS_SCVERIFY) && !defined(AC_CHANNEL_STATIC_FIFO)
+#define __AC_CHANNEL_COUNT
+#endif
+
 // Macro Definitions (obsolete - provided here for backward compatibility)
 #define AC_CHAN_CTOR(varname) varname
 #define AC_CHAN_CTOR_INIT(varname,init) varname(init)
@@ -91,7 +117,9 @@ struct ac_channel_exception {
     no_insert_defined_for_channel_type,
     no_size_in_connections,
     no_num_free_in_connections,
-    no_output_empty_in_connections
+    no_output_empty_in_connections,
+    batch_larger_than_channel_depth,
+    write_to_full_channel
   };
   static inline const char *msg(const code &code_) {
       static const char *const s[] = {
@@ -103,9 +131,265 @@ struct ac_channel_exception {
           "No insert defined for channel type",
           "Connections does not support size()",
           "Connections does not support num_free()",
-          "Connections::Out does not support empty()"
+          "Connections::Out does not support empty()",
+          "acquire_read/acquire_write larger than channel depth",
+          "Write to full channel"
       };
-      return s[code_-code_begin];
+      return s[(int)code_-(int)code_begin];
+  }
+};
+
+#ifdef __AC_CHANNEL_RING
+///////////////////////////////////////////
+// Class: ac_channel_scheduler
+//   Installed per thread by a runtime that runs blocks concurrently or
+//   cooperatively (see ac_dataflow.h). A blocking read/peek on an empty
+//   channel or write on a full channel calls wait(for_write) and retries,
+//   instead of asserting.
+//   wait() may return (to retry) or throw to abandon the blocked call.
+//   notify() is called by a channel after a transaction that may unblock a
+//   waiting side, on the thread that made it.
+//////////////////////////////////////////
+class ac_channel_scheduler {
+public:
+  virtual ~ac_channel_scheduler() {}
+  virtual void wait(bool for_write) = 0;
+  virtual void notify() {}
+
+  static ac_channel_scheduler *&current() {
+    static thread_local ac_channel_scheduler *s = 0;
+    return s;
+  }
+};
+
+///////////////////////////////////////////
+// Class: ac_channel_yield_scheduler
+//   Minimal scheduler for threads started by the user: installed on the
+//   constructing thread for its lifetime, a blocked call spins and then
+//   yields the thread until the other side makes progress.
+//     std::thread t([&]{ ac_channel_yield_scheduler s; producer(c); });
+//////////////////////////////////////////
+class ac_channel_yield_scheduler : public ac_channel_scheduler {
+  ac_channel_scheduler *prev;
+  unsigned int spins;
+  ac_channel_yield_scheduler(const ac_channel_yield_scheduler &);
+  ac_channel_yield_scheduler &operator=(const ac_channel_yield_scheduler &);
+public:
+  ac_channel_yield_scheduler() : prev(current()), spins(0) { current() = this; }
+  ~ac_channel_yield_scheduler() { current() = prev; }
+  void wait(bool) {
+    if (++spins > 64) {
+      spins = 0;
+      std::this_thread::yield();
+    }
+  }
+};
+#endif
+
+///////////////////////////////////////////
+// Class: ac_channel_hwm
+//   High-water mark of a channel: raised by the writing thread, read by any
+//   thread through max_size() and the channel registry (relaxed atomic when
+//   channels may be shared between threads)
+//////////////////////////////////////////
+class ac_channel_hwm {
+#ifdef __AC_CHANNEL_RING
+  std::atomic<unsigned int> v;
+public:
+  ac_channel_hwm() : v(0) {}
+  unsigned int get() const { return v.load(std::memory_order_relaxed); }
+  void note(unsigned int n) {
+    if (n > v.load(std::memory_order_relaxed))
+      v.store(n, std::memory_order_relaxed);
+  }
+#else
+  unsigned int v;
+public:
+  ac_channel_hwm() : v(0) {}
+  unsigned int get() const { return v; }
+  void note(unsigned int n) {
+    if (n > v)
+      v = n;
+  }
+#endif
+};
+
+///////////////////////////////////////////
+// Class: ac_channel_depth
+//   Constructor argument of a bounded channel: ac_channel<T> c(ac_channel_depth(16));
+//////////////////////////////////////////
+struct ac_channel_depth {
+  unsigned int depth;
+  explicit ac_channel_depth(unsigned int d) : depth(d) {}
+};
+
+///////////////////////////////////////////
+// Class: ac_channel_write_observer
+//   Sees every element written to the channel it is attached to with
+//   ac_channel<T>::set_write_observer, in channel order. Channels call it only
+//   when compiled with -DAC_CHANNEL_TRACE (see ac_channel_trace.h)
+//////////////////////////////////////////
+template <class T>
+class ac_channel_write_observer {
+public:
+  virtual ~ac_channel_write_observer() {}
+  virtual void written(const T *p, unsigned int n) = 0;
+};
+
+///////////////////////////////////////////
+// Struct: ac_channel_stats
+//   Per channel counters kept when compiled with -DAC_CHANNEL_INSTRUMENT
+//   (define it for every translation unit). Reader side and writer side
+//   counters are separate so a channel crossing two threads stays race free.
+//   Occupancy is sampled before every read/peek/write transaction.
+//////////////////////////////////////////
+struct ac_channel_stats {
+  // reader side
+  unsigned long long reads;
+  unsigned long long peeks;
+  unsigned long long nb_read_fails;
+  unsigned long long empty_ops;       // read/peek transactions that found the channel empty
+  unsigned long long size_sum_r;
+  // writer side
+  unsigned long long writes;
+  unsigned long long nb_write_fails;
+  unsigned long long full_ops;        // write transactions that found a bounded channel full
+  unsigned long long size_sum_w;
+
+  ac_channel_stats() : reads(0), peeks(0), nb_read_fails(0), empty_ops(0), size_sum_r(0),
+                       writes(0), nb_write_fails(0), full_ops(0), size_sum_w(0) {}
+  unsigned long long transactions() const { return reads + peeks + writes; }
+  double mean_size() const { return transactions() ? (double) (size_sum_r + size_sum_w) / transactions() : 0.0; }
+};
+
+///////////////////////////////////////////
+// Class: ac_channel_stats_sink
+//   Receives one call per named channel from ac_channel_registry::report().
+//   stats is null unless compiled with AC_CHANNEL_INSTRUMENT
+//////////////////////////////////////////
+class ac_channel_stats_sink {
+public:
+  virtual ~ac_channel_stats_sink() {}
+  virtual void begin() {}
+  virtual void channel(const std::string &name, unsigned int depth, unsigned int size, unsigned int max_size, const ac_channel_stats *stats) = 0;
+  virtual void end() {}
+};
+
+///////////////////////////////////////////
+// Class: ac_channel_registry
+//   Named channels (ac_channel<T>::set_name) are listed here with their depth,
+//   current size and maximum occupancy, so FIFO depths can be sized from a
+//   simulation run:  ac_channel_registry::dump(std::cout);
+//   Channels are named/destroyed outside of concurrently running blocks.
+//////////////////////////////////////////
+class ac_channel_registry {
+public:
+  struct entry {
+    std::string name;
+    entry *prev;
+    entry *next;
+    entry(const char *n) : name(n), prev(0), next(0) { add(this); }
+    virtual ~entry() { remove(this); }
+    virtual unsigned int depth() const = 0;     // 0: unbounded
+    virtual unsigned int size() const = 0;
+    virtual unsigned int max_size() const = 0;  // high-water mark
+    virtual const ac_channel_stats *stats() const { return 0; }
+  };
+
+  static entry *first() { return head(); }
+
+  static void report(ac_channel_stats_sink &sink) {
+    sink.begin();
+    for (const entry *e = first(); e; e = e->next)
+      sink.channel(e->name, e->depth(), e->size(), e->max_size(), e->stats());
+    sink.end();
+  }
+
+  // depth 0 is an unbounded channel; counter fields are omitted without AC_CHANNEL_INSTRUMENT
+  static void write_json(std::ostream &os) {
+    json_sink s(os);
+    report(s);
+  }
+  static void write_csv(std::ostream &os) {
+    csv_sink s(os);
+    report(s);
+  }
+
+  static void dump(std::ostream &os) {
+    os << std::left << std::setw(32) << "channel" << std::right
+       << std::setw(10) << "depth" << std::setw(10) << "size" << std::setw(10) << "max_size" << std::endl;
+    for (const entry *e = first(); e; e = e->next) {
+      os << std::left << std::setw(32) << e->name << std::right << std::setw(10);
+      if (e->depth())
+        os << e->depth();
+      else
+        os << "-";
+      os << std::setw(10) << e->size() << std::setw(10) << e->max_size() << std::endl;
+    }
+  }
+
+private:
+  class json_sink : public ac_channel_stats_sink {
+    std::ostream &os;
+    bool first_ch;
+  public:
+    json_sink(std::ostream &os_) : os(os_), first_ch(true) {}
+    void begin() { os << "{\"channels\": ["; }
+    void channel(const std::string &name, unsigned int depth, unsigned int size, unsigned int max_size, const ac_channel_stats *st) {
+      os << (first_ch ? "\n" : ",\n") << "  {\"name\": \"";
+      first_ch = false;
+      for (unsigned int i=0; i<name.size(); i++) {
+        if (name[i] == '"' || name[i] == '\\')
+          os << '\\';
+        os << name[i];
+      }
+      os << "\", \"depth\": " << depth << ", \"size\": " << size << ", \"max_size\": " << max_size;
+      if (st) {
+        os << ", \"reads\": " << st->reads << ", \"writes\": " << st->writes << ", \"peeks\": " << st->peeks
+           << ", \"nb_read_fails\": " << st->nb_read_fails << ", \"nb_write_fails\": " << st->nb_write_fails
+           << ", \"empty_ops\": " << st->empty_ops << ", \"full_ops\": " << st->full_ops
+           << ", \"mean_size\": " << st->mean_size();
+      }
+      os << "}";
+    }
+    void end() { os << "\n]}" << std::endl; }
+  };
+
+  class csv_sink : public ac_channel_stats_sink {
+    std::ostream &os;
+  public:
+    csv_sink(std::ostream &os_) : os(os_) {}
+    void begin() { os << "name,depth,size,max_size,reads,writes,peeks,nb_read_fails,nb_write_fails,empty_ops,full_ops,mean_size" << std::endl; }
+    void channel(const std::string &name, unsigned int depth, unsigned int size, unsigned int max_size, const ac_channel_stats *st) {
+      os << name << "," << depth << "," << size << "," << max_size;
+      if (st) {
+        os << "," << st->reads << "," << st->writes << "," << st->peeks << "," << st->nb_read_fails << "," << st->nb_write_fails
+           << "," << st->empty_ops << "," << st->full_ops << "," << st->mean_size();
+      } else
+        os << ",,,,,,,,";
+      os << std::endl;
+    }
+  };
+
+  static entry *&head() {
+    static entry *h = 0;
+    return h;
+  }
+  static entry *&tail() {
+    static entry *t = 0;
+    return t;
+  }
+  static void add(entry *e) {
+    e->prev = tail();
+    if (tail())
+      tail()->next = e;
+    else
+      head() = e;
+    tail() = e;
+  }
+  static void remove(entry *e) {
+    (e->prev ? e->prev->next : head()) = e->next;
+    (e->next ? e->next->prev : tail()) = e->prev;
   }
 };
 
@@ -122,6 +406,8 @@ public:
   ac_channel();
   ac_channel(int init);
   ac_channel(int init, T val);
+  // bounded channel: nb_write fails when full, write waits (ac_channel_scheduler) or asserts
+  ac_channel(const ac_channel_depth &d);
 
   T read() { return chan.read(); }
   void read(T& t) { t = read(); }
@@ -154,6 +440,48 @@ public:
 
   int get_size_call_count() { return chan.get_size_call_count(); }
 
+  // Depth of a bounded channel (0: unbounded, the default). Setting a depth
+  // smaller than the current size keeps the contents
+  void set_depth(unsigned int d) { chan.set_depth(d); }
+  unsigned int depth() const { return chan.depth(); }
+  // maximum number of entries the channel has held
+  unsigned int max_size() const { return chan.max_size(); }
+  // register the channel in ac_channel_registry under this name
+  void set_name(const char *name) { chan.set_name(name); }
+#ifdef AC_CHANNEL_TRACE
+  // observer of written elements (null: none)
+  void set_write_observer(ac_channel_write_observer<T> *o) { chan.set_write_observer(o); }
+#endif
+
+  // Batch transfers: same as n read()/write() calls
+  void read_n(T *p, unsigned int n) { chan.read_n(p, n); }
+  void write_n(const T *p, unsigned int n) { chan.write_n(p, n); }
+
+  // Direct access to k contiguous elements. acquire_read waits (or asserts,
+  // like read) until k entries are available and returns them in channel
+  // order; release_read(k) then removes them. acquire_write returns room for
+  // k entries that are published by commit_write(k). Pointers stay valid
+  // until the matching release/commit. Where the backend storage is not
+  // contiguous (deque, ring wrap-around) the entries go through a staging
+  // buffer. SystemC/Connections backends read the entries at acquire_read.
+  const T *acquire_read(unsigned int k) { return chan.acquire_read(k); }
+  void release_read(unsigned int k) { chan.release_read(k); }
+  T *acquire_write(unsigned int k) { return chan.acquire_write(k); }
+  void commit_write(unsigned int k) { chan.commit_write(k); }
+
+#ifdef __AC_CHANNEL_RING
+  // Switch to a bounded lock-free ring of the given depth so that the writer
+  // and the reader may run on different threads. Current contents are kept.
+  // read/peek on an empty ring and write on a full ring wait for the other side
+  // through the thread's ac_channel_scheduler (ac_dataflow.h installs one,
+  // threads of the user can install an ac_channel_yield_scheduler), and assert
+  // like the deque backend when none is installed
+  void use_ring_buffer(unsigned int depth) { chan.use_ring(depth); }
+  // true when the writer and the reader may run on different threads (ring
+  // or counting backend)
+  bool thread_safe() const { return chan.thread_safe(); }
+#endif
+
 #ifdef SYSTEMC_INCLUDED
   void bind(sc_core::sc_fifo_in<T> &f) { chan.bind(f); }
   void bind(sc_core::sc_fifo_out<T> &f) { chan.bind(f); }
@@ -201,7 +529,9 @@ public:
         fifo_ac_channel_type,
         fifo_sc_fifo_type,
         fifo_connections_type,
-        fifo_connections_sync_type
+        fifo_connections_sync_type,
+        fifo_ring_type,
+        fifo_count_type
     };
 
     struct fifo_abstract {
@@ -219,18 +549,70 @@ public:
       virtual unsigned int num_free() const = 0;
       virtual void reset() = 0;
       virtual const T &operator_sb(const unsigned int &pos, const T &default_value) const = 0;
+      virtual unsigned int depth() const { return 0; }
+      virtual unsigned int max_size() const { return 0; }
+
+      // batch operations, element by element through a staging buffer unless
+      // the backend provides direct access
+      struct stage_buf {
+        T *p;
+        unsigned int n;
+        stage_buf() : p(0), n(0) {}
+        ~stage_buf() { delete [] p; }
+        T *get(unsigned int k) {
+          if (k > n) {
+            delete [] p;
+            p = new T[k];
+            n = k;
+          }
+          return p;
+        }
+      private:
+        stage_buf(const stage_buf &);
+        stage_buf &operator=(const stage_buf &);
+      };
+      stage_buf stage;
+
+      virtual void read_n(T *p, unsigned int n) {
+        for (unsigned int i=0; i<n; i++)
+          p[i] = read();
+      }
+      virtual void write_n(const T *p, unsigned int n) {
+        for (unsigned int i=0; i<n; i++)
+          write(p[i]);
+      }
+      virtual const T *acquire_read(unsigned int k) {
+        T *p = stage.get(k);
+        read_n(p, k);
+        return p;
+      }
+      virtual void release_read(unsigned int) {}
+      virtual T *acquire_write(unsigned int k) { return stage.get(k); }
+      virtual void commit_write(unsigned int k) { write_n(stage.p, k); }
     };
 
     struct fifo_ac_channel : fifo_abstract {
       std::deque<T> ch;
+      unsigned int bound;  // 0: unbounded
+      ac_channel_hwm hwm;  // high-water mark
 
+      fifo_ac_channel() : bound(0) {}
       ~fifo_ac_channel() {}
 
       static inline fifo_type ftype() { return fifo_ac_channel_type; }
 
       fifo_type get_fifo_type() const { return ftype(); }
 
+      // calls inside the class are qualified so that the inline instance used
+      // by fifo is dispatched statically
       template <bool isRead> T readOrPeek() {
+#ifdef __AC_CHANNEL_RING
+        if (fifo_ac_channel::empty()) {
+          ac_channel_scheduler *sch = ac_channel_scheduler::current();
+          while (sch && fifo_ac_channel::empty())
+            sch->wait(false);
+        }
+#endif
         {
           // If you hit this assert you attempted a read or peek on an empty channel. Perhaps
           // you need to guard the execution of the read/peek with a call to the available()
@@ -241,7 +623,7 @@ public:
           //      cout << myInputChan.read();
           //    }
 #if !defined(CCS_SCVERIFY) && !defined(__SYNTHESIS__) && defined(AC_CHANNEL_READ_FAIL_TB)
-          if (empty()) {
+          if (fifo_ac_channel::empty()) {
             std::cerr << std::endl << "Error: Empty channel " << (isRead ? "read" : "peek" ) << " attempt from here:" << std::endl;
             std::stringstream key;
             // call stack will be #1 ac_channel<T>::fifo::fifo_ac_channel::readOrPeek()
@@ -253,7 +635,7 @@ public:
             std::cerr << ac_debug::format_stack_trace(key.str()) << std::endl;
           }
 #endif
-          AC_CHANNEL_ASSERT(!empty(), (isRead ? ac_channel_exception::read_from_empty_channel : ac_channel_exception::peek_from_empty_channel));
+          AC_CHANNEL_ASSERT(!fifo_ac_channel::empty(), (isRead ? ac_channel_exception::read_from_empty_channel : ac_channel_exception::peek_from_empty_channel));
         }
         T t = ch.front();
         if (isRead) 
@@ -263,27 +645,467 @@ public:
       T read() {
             return readOrPeek<true>();
         }
-      bool nb_read(T& t) { return empty() ? false : (t = read(), true); }
+      bool nb_read(T& t) { return ch.empty() ? false : (t = readOrPeek<true>(), true); }
 
       T peek() {
             return readOrPeek<false>();
         }
-      bool nb_peek(T& t) { return empty() ? false : (t = peek(), true); }
+      bool nb_peek(T& t) { return ch.empty() ? false : (t = readOrPeek<false>(), true); }
 
-      void write(const T& t) { ch.push_back(t); }
-      bool nb_write(const T& t) { return !num_free() ? false : (write(t), true); }
+      void push(const T& t) {
+        ch.push_back(t);
+        hwm.note(ch.size());
+      }
+      void write(const T& t) {
+        if (bound && ch.size() >= bound) {
+#ifdef __AC_CHANNEL_RING
+          ac_channel_scheduler *sch = ac_channel_scheduler::current();
+          while (sch && ch.size() >= bound)
+            sch->wait(true);
+#endif
+          AC_CHANNEL_ASSERT(ch.size() < bound, ac_channel_exception::write_to_full_channel);
+        }
+        push(t);
+      }
+      bool nb_write(const T& t) { return !fifo_ac_channel::num_free() ? false : (push(t), true); }
 
-      bool empty() {  return size() == 0; }
-      bool available(unsigned int k) const { return size() >= k; }
+      bool empty() {  return ch.empty(); }
+      bool available(unsigned int k) const { return ch.size() >= k; }
       unsigned int size() const { return (int)ch.size(); }
-      unsigned int num_free() const { return ch.max_size() - ch.size(); }
+      unsigned int num_free() const {
+        if (bound)
+          return ch.size() < bound ? bound - ch.size() : 0;
+        return ch.max_size() - ch.size();
+      }
+      unsigned int depth() const { return bound; }
+      unsigned int max_size() const { return hwm.get(); }
 
       void reset() { ch.clear(); }
 
       const T &operator_sb(const unsigned int &pos, const T &) const {
         return ch[pos];
       }
+
+      // false: the k elements are not there (the assert returned)
+      bool wait_available(unsigned int k) {
+#ifdef __AC_CHANNEL_RING
+        if (ch.size() < k) {
+          ac_channel_scheduler *sch = ac_channel_scheduler::current();
+          while (sch && ch.size() < k)
+            sch->wait(false);
+        }
+#endif
+        AC_CHANNEL_ASSERT(ch.size() >= k, ac_channel_exception::read_from_empty_channel);
+        return ch.size() >= k;
+      }
+      // on a bounded channel a batch larger than the depth is moved in pieces
+      // of at most the depth, as the writer can never get further ahead
+      void read_n(T *p, unsigned int n) {
+        while (n) {
+          const unsigned int k = bound && n > bound ? bound : n;
+          if (!wait_available(k))
+            return;
+          std::copy(ch.begin(), ch.begin() + k, p);
+          ch.erase(ch.begin(), ch.begin() + k);
+          p += k;
+          n -= k;
+        }
+      }
+      void write_n(const T *p, unsigned int n) {
+        if (bound) {
+          for (unsigned int i=0; i<n; i++)
+            fifo_ac_channel::write(p[i]);
+          return;
+        }
+        ch.insert(ch.end(), p, p + n);
+        hwm.note(ch.size());
+      }
+      const T *acquire_read(unsigned int k) {
+        AC_CHANNEL_ASSERT(!bound || k <= bound, ac_channel_exception::batch_larger_than_channel_depth);
+        T *p = this->stage.get(k);
+        if (wait_available(k))
+          std::copy(ch.begin(), ch.begin() + k, p);
+        return p;
+      }
+      void release_read(unsigned int k) { ch.erase(ch.begin(), ch.begin() + k); }
+    };
+
+#ifdef __AC_CHANNEL_RING
+    struct fifo_ring : fifo_abstract {
+      // head is only written by the reader and tail only by the writer, each
+      // side keeps a cached copy of the other index to avoid touching its
+      // cache line on every access. Indices grow freely, slot = index & mask
+      enum { cache_line = 64 };
+      char pad0[cache_line];
+      std::atomic<unsigned int> head;
+      unsigned int tail_cache;
+      char pad1[cache_line];
+      std::atomic<unsigned int> tail;
+      unsigned int head_cache;
+      bool staged_write;
+      ac_channel_hwm hwm;  // high-water mark, seen by the writer (may overestimate by stale head_cache)
+      char pad2[cache_line];
+      unsigned int bound;
+      unsigned int mask;
+      T *buf;              // not std::vector: ac_channel<bool> needs real elements
+
+      fifo_ring() : head(0), tail_cache(0), tail(0), head_cache(0), staged_write(false), bound(0), mask(0), buf(0) {}
+      ~fifo_ring() { delete [] buf; }
+
+      void init(unsigned int d) {
+        bound = d ? d : 1;
+        unsigned int cap = 1;
+        while(cap < bound)
+          cap <<= 1;
+        mask = cap - 1;
+        delete [] buf;
+        buf = new T[cap];
+      }
+
+      static inline fifo_type ftype() { return fifo_ring_type; }
+
+      fifo_type get_fifo_type() const { return ftype(); }
+
+      // wait for the other side through the scheduler; without one the
+      // channel asserts like the deque backend. false: nothing to wait for,
+      // the caller then leaves the ring unchanged (read returns T(), write
+      // drops the element) in case the assert returns
+      static inline bool wait(ac_channel_exception::code code) {
+        if(ac_channel_scheduler *sch = ac_channel_scheduler::current()) {
+          sch->wait(code == ac_channel_exception::write_to_full_channel);
+          return true;
+        }
+        AC_CHANNEL_ASSERT(false, code);
+        return false;
+      }
+      // head or tail moved: wake a side waiting through the scheduler
+      static inline void notify() {
+        if(ac_channel_scheduler *sch = ac_channel_scheduler::current())
+          sch->notify();
+      }
+
+      // reader side
+      bool ready(unsigned int k) {
+        const unsigned int h = head.load(std::memory_order_relaxed);
+        if(tail_cache - h >= k)
+          return true;
+        tail_cache = tail.load(std::memory_order_acquire);
+        return tail_cache - h >= k;
+      }
+      template <bool isRead> T readOrPeek() {
+        while(!ready(1))
+          if(!wait(isRead ? ac_channel_exception::read_from_empty_channel : ac_channel_exception::peek_from_empty_channel))
+            return T();
+        const unsigned int h = head.load(std::memory_order_relaxed);
+        T t = buf[h & mask];
+        if(isRead) {
+          head.store(h + 1, std::memory_order_release);
+          notify();
+        }
+        return t;
+      }
+      T read() { return readOrPeek<true>(); }
+      bool nb_read(T& t) { return !ready(1) ? false : (t = read(), true); }
+
+      T peek() { return readOrPeek<false>(); }
+      bool nb_peek(T& t) { return !ready(1) ? false : (t = peek(), true); }
+
+      // writer side
+      bool has_room(unsigned int k = 1) {
+        const unsigned int t = tail.load(std::memory_order_relaxed);
+        if(t - head_cache + k <= bound)
+          return true;
+        head_cache = head.load(std::memory_order_acquire);
+        return t - head_cache + k <= bound;
+      }
+      void note_size(unsigned int t) {
+        hwm.note(t - head_cache);
+      }
+      void push(const T& v) {
+        const unsigned int t = tail.load(std::memory_order_relaxed);
+        buf[t & mask] = v;
+        tail.store(t + 1, std::memory_order_release);
+        note_size(t + 1);
+        notify();
+      }
+      void write(const T& v) {
+        while(!has_room())
+          if(!wait(ac_channel_exception::write_to_full_channel))
+            return;
+        push(v);
+      }
+      bool nb_write(const T& v) { return !has_room() ? false : (push(v), true); }
+
+      bool empty() { return size() == 0; }
+      bool available(unsigned int k) const { return size() >= k; }
+      unsigned int size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+      unsigned int num_free() const { return bound - size(); }
+      unsigned int depth() const { return bound; }
+      unsigned int max_size() const { return hwm.get(); }
+
+      void reset() {
+        head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+        notify();
+      }
+
+      const T &operator_sb(const unsigned int &pos, const T &) const {
+        return buf[(head.load(std::memory_order_acquire) + pos) & mask];
+      }
+
+      // batches larger than the depth are moved in pieces as room/data appears
+      void read_n(T *p, unsigned int n) {
+        while(n) {
+          if(!ready(1)) {
+            if(!wait(ac_channel_exception::read_from_empty_channel))
+              return;
+            continue;
+          }
+          const unsigned int h = head.load(std::memory_order_relaxed);
+          unsigned int c = tail_cache - h;
+          c = c < n ? c : n;
+          for(unsigned int i=0; i<c; i++)
+            p[i] = buf[(h + i) & mask];
+          head.store(h + c, std::memory_order_release);
+          notify();
+          p += c;
+          n -= c;
+        }
+      }
+      void write_n(const T *p, unsigned int n) {
+        while(n) {
+          if(!has_room()) {
+            if(!wait(ac_channel_exception::write_to_full_channel))
+              return;
+            continue;
+          }
+          const unsigned int t = tail.load(std::memory_order_relaxed);
+          unsigned int c = bound - (t - head_cache);
+          c = c < n ? c : n;
+          for(unsigned int i=0; i<c; i++)
+            buf[(t + i) & mask] = p[i];
+          tail.store(t + c, std::memory_order_release);
+          note_size(t + c);
+          notify();
+          p += c;
+          n -= c;
+        }
+      }
+      const T *acquire_read(unsigned int k) {
+        AC_CHANNEL_ASSERT(k <= bound, ac_channel_exception::batch_larger_than_channel_depth);
+        while(!ready(k))
+          if(!wait(ac_channel_exception::read_from_empty_channel))
+            return this->stage.get(k);
+        const unsigned int h = head.load(std::memory_order_relaxed) & mask;
+        if(h + k <= mask + 1)
+          return &buf[h];
+        T *p = this->stage.get(k);
+        for(unsigned int i=0; i<k; i++)
+          p[i] = buf[(h + i) & mask];
+        return p;
+      }
+      void release_read(unsigned int k) {
+        if(!ready(k))
+          return;
+        head.store(head.load(std::memory_order_relaxed) + k, std::memory_order_release);
+        notify();
+      }
+      T *acquire_write(unsigned int k) {
+        AC_CHANNEL_ASSERT(k <= bound, ac_channel_exception::batch_larger_than_channel_depth);
+        while(!has_room(k))
+          if(!wait(ac_channel_exception::write_to_full_channel))
+            return this->stage.get(k);
+        const unsigned int t = tail.load(std::memory_order_relaxed) & mask;
+        staged_write = t + k > mask + 1;
+        if(!staged_write)
+          return &buf[t];
+        return this->stage.get(k);
+      }
+      void commit_write(unsigned int k) {
+        if(!has_room(k))
+          return;
+        const unsigned int t = tail.load(std::memory_order_relaxed);
+        if(staged_write)
+          for(unsigned int i=0; i<k; i++)
+            buf[(t + i) & mask] = this->stage.p[i];
+        staged_write = false;
+        tail.store(t + k, std::memory_order_release);
+        note_size(t + k);
+        notify();
+      }
     };
+#endif
+
+#ifdef __AC_CHANNEL_COUNT
+    // Elements are counted, not stored: every read returns the value given to
+    // use_count() (written values are dropped), so only the count is shared
+    // between threads. Reading an empty channel asserts unless a scheduler is
+    // installed or the channel was switched to blocking mode by use_ring(), in
+    // which case the reader (or a writer of a full channel) sleeps on a
+    // condition variable
+    struct fifo_count : fifo_abstract {
+#ifdef __AC_CHANNEL_RING
+      std::atomic<unsigned int> n;
+      std::atomic<unsigned int> sleepers;
+      std::mutex m;
+      std::condition_variable cv;
+#else
+      unsigned int n;
+#endif
+      ac_channel_hwm hwm;  // high-water mark
+      T v;                 // read value, set before the channel is shared
+      unsigned int bound;  // 0: unbounded
+      bool blocking;
+
+      fifo_count() : n(0), v(), bound(0), blocking(false) {
+#ifdef __AC_CHANNEL_RING
+        sleepers = 0;
+#endif
+      }
+      ~fifo_count() {}
+
+      static inline fifo_type ftype() { return fifo_count_type; }
+
+      fifo_type get_fifo_type() const { return ftype(); }
+
+      unsigned int count() const {
+#ifdef __AC_CHANNEL_RING
+        return n.load(std::memory_order_acquire);
+#else
+        return n;
+#endif
+      }
+      bool room(unsigned int c, unsigned int k) const { return !bound || c + k <= bound; }
+
+      // try to remove/add k elements
+      bool take(unsigned int k) {
+#ifdef __AC_CHANNEL_RING
+        unsigned int c = n.load();
+        while (c >= k)
+          if (n.compare_exchange_weak(c, c - k)) {
+            wake();
+            return true;
+          }
+        return false;
+#else
+        if (n < k)
+          return false;
+        n -= k;
+        return true;
+#endif
+      }
+      bool give(unsigned int k) {
+#ifdef __AC_CHANNEL_RING
+        unsigned int c = n.load();
+        while (room(c, k))
+          if (n.compare_exchange_weak(c, c + k)) {
+            hwm.note(c + k);
+            wake();
+            return true;
+          }
+        return false;
+#else
+        if (!room(n, k))
+          return false;
+        n += k;
+        hwm.note(n);
+        return true;
+#endif
+      }
+
+#ifdef __AC_CHANNEL_RING
+      // sleepers is raised before the waiter tests the count and tested after
+      // the count changes, so a change is never missed by a sleeping waiter
+      void wake() {
+        if (sleepers.load()) {
+          { std::lock_guard<std::mutex> lk(m); }
+          cv.notify_all();
+        }
+        if (ac_channel_scheduler *sch = ac_channel_scheduler::current())
+          sch->notify();
+      }
+#endif
+      // wait until k elements (for_write: room for k elements) are there.
+      // false: nothing to wait for, the channel asserted and the caller
+      // leaves it unchanged in case the assert returns (see fifo_ring::wait)
+      bool wait(unsigned int k, bool for_write) {
+#ifdef __AC_CHANNEL_RING
+        if (ac_channel_scheduler *sch = ac_channel_scheduler::current()) {
+          while (for_write ? !room(count(), k) : count() < k)
+            sch->wait(for_write);
+          return true;
+        }
+        if (blocking) {
+          std::unique_lock<std::mutex> lk(m);
+          sleepers++;
+          while (for_write ? !room(count(), k) : count() < k)
+            cv.wait(lk);
+          sleepers--;
+          return true;
+        }
+#endif
+        AC_CHANNEL_ASSERT(for_write ? room(count(), k) : count() >= k,
+                          (for_write ? ac_channel_exception::write_to_full_channel : ac_channel_exception::read_from_empty_channel));
+        return false;
+      }
+
+      T read() {
+        while (!take(1))
+          if (!wait(1, false))
+            break;
+        return v;
+      }
+      bool nb_read(T& t) { return take(1) ? (t = v, true) : false; }
+
+      T peek() {
+        if (!count())
+          wait(1, false);
+        AC_CHANNEL_ASSERT(count(), ac_channel_exception::peek_from_empty_channel);
+        return v;
+      }
+      bool nb_peek(T& t) { return count() ? (t = v, true) : false; }
+
+      void write(const T&) {
+        while (!give(1))
+          if (!wait(1, true))
+            return;
+      }
+      bool nb_write(const T&) { return give(1); }
+
+      bool empty() { return !count(); }
+      bool available(unsigned int k) const { return count() >= k; }
+      unsigned int size() const { return count(); }
+      unsigned int num_free() const {
+        const unsigned int c = count();
+        if (bound)
+          return c < bound ? bound - c : 0;
+        return ~0u - c;
+      }
+      unsigned int depth() const { return bound; }
+      unsigned int max_size() const { return hwm.get(); }
+
+      void reset() { n = 0; }
+
+      const T &operator_sb(const unsigned int &, const T &) const { return v; }
+
+      void read_n(T *p, unsigned int k) {
+        while (!take(k))
+          if (!wait(k, false))
+            return;
+        for (unsigned int i=0; i<k; i++)
+          p[i] = v;
+      }
+      void write_n(const T *, unsigned int k) {
+        if (bound) {
+          for (unsigned int i=0; i<k; i++)
+            while (!give(1))
+              if (!wait(1, true))
+                return;
+          return;
+        }
+        give(k);
+      }
+    };
+#endif
 
 #ifdef SYSTEMC_INCLUDED
     struct fifo_sc_fifo : fifo_abstract {
@@ -440,50 +1262,249 @@ private:
   private:
 #endif
 
+    // The deque backend is held inline (sf) and used whenever f is null, so
+    // the default channel needs no heap allocation and its operations are
+    // called without virtual dispatch. Other backends are allocated in f.
     template<typename fifo_T>
     fifo_T &get_fifo() {
-      if (!f || f->get_fifo_type() != fifo_T::ftype()) {
+      if (fifo_T::ftype() == fifo_ac_channel_type) {
         if (f) {
           AC_CHANNEL_ASSERT(f->empty(), ac_channel_exception::fifo_not_empty_when_reset);
           delete f;
+          f = 0;
         }
+        return static_cast<fifo_T &>(static_cast<fifo_abstract &>(sf));
+      }
+      if (!f || f->get_fifo_type() != fifo_T::ftype()) {
+        if (f) {
+          AC_CHANNEL_ASSERT(f->empty(), ac_channel_exception::fifo_not_empty_when_reset);
+          delete f;
+        } else
+          AC_CHANNEL_ASSERT(sf.empty(), ac_channel_exception::fifo_not_empty_when_reset);
         f = new fifo_T;
       }
       return static_cast<fifo_T &>(*f);
     }
 
+#ifndef AC_CHANNEL_STATIC_FIFO
+    inline bool dyn() const { return f != 0; }
+#else
+    // only the inline deque backend: f is never set
+    inline bool dyn() const { return false; }
+#endif
+    fifo_abstract &cur() { return dyn() ? *f : static_cast<fifo_abstract &>(sf); }
+    const fifo_abstract &cur() const { return dyn() ? *f : static_cast<const fifo_abstract &>(sf); }
+
+    struct reg_entry : ac_channel_registry::entry {
+      const fifo &ff;
+      reg_entry(const fifo &ff_, const char *name) : ac_channel_registry::entry(name), ff(ff_) {}
+      unsigned int depth() const { return ff.depth(); }
+      unsigned int size() const { return ff.size(); }
+      unsigned int max_size() const { return ff.max_size(); }
+#ifdef AC_CHANNEL_INSTRUMENT
+      const ac_channel_stats *stats() const { return &ff.st; }
+#endif
+    };
+
+    fifo_ac_channel sf;
     fifo_abstract *f;
+    reg_entry *reg;
+#ifdef AC_CHANNEL_INSTRUMENT
+    ac_channel_stats st;
+#endif
+
+    // instrumentation, empty unless AC_CHANNEL_INSTRUMENT. Blocking operations
+    // record before the transaction, nb_ ones after it with 'adj' restoring
+    // the size seen by the transaction
+#ifdef AC_CHANNEL_INSTRUMENT
+    inline void stat_rd(unsigned int n, bool peek, bool ok, int adj = 0) {
+      const unsigned int sz = stat_size() + adj;
+      st.empty_ops += !sz;
+      if (!ok)
+        st.nb_read_fails++;
+      else {
+        (peek ? st.peeks : st.reads) += n;
+        st.size_sum_r += (unsigned long long) sz * n;
+      }
+    }
+    inline void stat_wr(unsigned int n, bool ok, int adj = 0) {
+      const unsigned int sz = stat_size() + adj;
+      const unsigned int d = dyn() ? f->depth() : sf.bound;
+      st.full_ops += d && sz >= d;
+      if (!ok)
+        st.nb_write_fails++;
+      else {
+        st.writes += n;
+        st.size_sum_w += (unsigned long long) sz * n;
+      }
+    }
+#else
+    inline void stat_rd(unsigned int, bool, bool, int = 0) {}
+    inline void stat_wr(unsigned int, bool, int = 0) {}
+#endif
+#ifdef AC_CHANNEL_TRACE
+    inline void trace_wr(const T *p, unsigned int n) {
+      if (obs)
+        obs->written(p, n);
+    }
+#else
+    inline void trace_wr(const T *, unsigned int) {}
+#endif
+#ifdef AC_CHANNEL_TRACE
+    ac_channel_write_observer<T> *obs;
+    T *wp;               // pending acquire_write
+#endif
+#ifdef AC_CHANNEL_INSTRUMENT
+    // size of the deque/ring backends (SystemC/Connections do not provide it)
+    unsigned int stat_size() const {
+      if (!dyn())
+        return sf.size();
+      return f->get_fifo_type() == fifo_ring_type || f->get_fifo_type() == fifo_count_type ? f->size() : 0;
+    }
+#endif
     unsigned int rSz;    // reset size
     T rVal;              // resetValue
     int size_call_count;
 
+    void init_fifo() {
+#ifdef AC_CHANNEL_TRACE
+      obs = 0;
+      wp = 0;
+#endif
+#if defined(__AC_CHANNEL_RING) && defined(AC_CHANNEL_RING_DEPTH)
+      use_ring(AC_CHANNEL_RING_DEPTH > rSz ? AC_CHANNEL_RING_DEPTH : rSz);
+#endif
+    }
+
   public:
-    fifo() : f(0), rSz(0), size_call_count(0) { get_fifo<fifo_ac_channel>(); }
-    fifo(int init) : f(0), rSz(init), size_call_count(0) { get_fifo<fifo_ac_channel>(); }
-    fifo(int init, T val) : f(0), rSz(init), rVal(val), size_call_count(0) { get_fifo<fifo_ac_channel>(); }
-    ~fifo() { delete f; }
+    fifo() : f(0), reg(0), rSz(0), size_call_count(0) { init_fifo(); }
+    fifo(int init) : f(0), reg(0), rSz(init), size_call_count(0) { init_fifo(); }
+    fifo(int init, T val) : f(0), reg(0), rSz(init), rVal(val), size_call_count(0) { init_fifo(); }
+    ~fifo() { delete reg; delete f; }
+
+    // depth of the deque/counting/ring backends. A ring is always bounded:
+    // d == 0 keeps its depth, otherwise it is rebuilt with depth d (at least
+    // its current size, like use_ring)
+    void set_depth(unsigned int d) {
+#ifdef __AC_CHANNEL_COUNT
+      if (dyn() && f->get_fifo_type() == fifo_count_type) {
+        static_cast<fifo_count *>(f)->bound = d;
+        return;
+      }
+#endif
+#ifdef __AC_CHANNEL_RING
+      if (dyn() && f->get_fifo_type() == fifo_ring_type) {
+        if (d)
+          use_ring(d);
+        return;
+      }
+#endif
+      sf.bound = d;
+    }
+    unsigned int depth() const { return cur().depth(); }
+    unsigned int max_size() const { return cur().max_size(); }
+    void set_name(const char *name) {
+      delete reg;
+      reg = new reg_entry(*this, name);
+    }
+#ifdef AC_CHANNEL_TRACE
+    void set_write_observer(ac_channel_write_observer<T> *o) { obs = o; }
+#endif
 
-    inline T read() { return f->read(); }
-    inline bool nb_read(T& t) { return f->nb_read(t); }
+#ifdef __AC_CHANNEL_COUNT
+    // switch an empty channel to the counting backend, whose reads return val
+    void use_count(const T &val) {
+      get_fifo<fifo_count>().v = val;
+#if defined(__AC_CHANNEL_RING) && defined(AC_CHANNEL_RING_DEPTH)
+      use_ring(AC_CHANNEL_RING_DEPTH);
+#endif
+    }
+#endif
 
-    inline T peek() { return f->peek(); }
-    inline bool nb_peek(T& t) { return f->nb_peek(t); }
+#ifdef __AC_CHANNEL_RING
+    bool thread_safe() const {
+      return dyn() && (f->get_fifo_type() == fifo_ring_type || f->get_fifo_type() == fifo_count_type);
+    }
+    void use_ring(unsigned int depth) {
+      // a counting channel stays one, bounded and shareable between threads
+      if (f && f->get_fifo_type() == fifo_count_type) {
+        fifo_count &c = static_cast<fifo_count &>(*f);
+        c.bound = depth < c.count() ? c.count() : depth;
+        c.blocking = true;
+        return;
+      }
+      // keep the current contents (e.g. the initial values of ac_channel(init,val))
+      std::deque<T> keep;
+      if (!f)
+        keep.swap(sf.ch);
+      else if (f->get_fifo_type() == fifo_ring_type) {
+        T t;
+        while (f->nb_read(t))
+          keep.push_back(t);
+      }
+      if (depth < keep.size())
+        depth = keep.size();
+      fifo_ring &r = get_fifo<fifo_ring>();
+      r.init(depth);
+      for (unsigned int i=0; i<keep.size(); i++)
+        r.push(keep[i]);
+    }
+#endif
+
+    inline T read() { stat_rd(1, false, true); return dyn() ? f->read() : sf.read(); }
+    inline bool nb_read(T& t) {
+      const bool ok = dyn() ? f->nb_read(t) : sf.nb_read(t);
+      stat_rd(1, false, ok, ok);
+      return ok;
+    }
+
+    inline T peek() { stat_rd(1, true, true); return dyn() ? f->peek() : sf.peek(); }
+    inline bool nb_peek(T& t) {
+      const bool ok = dyn() ? f->nb_peek(t) : sf.nb_peek(t);
+      stat_rd(1, true, ok);
+      return ok;
+    }
 
-    inline void write(const T& t) { f->write(t); }
-    inline bool nb_write(const T& t) { return f->nb_write(t); }
+    inline void write(const T& t) { stat_wr(1, true); if (dyn()) f->write(t); else sf.write(t); trace_wr(&t, 1); }
+    inline bool nb_write(const T& t) {
+      const bool ok = dyn() ? f->nb_write(t) : sf.nb_write(t);
+      stat_wr(1, ok, -(int) ok);
+      if (ok)
+        trace_wr(&t, 1);
+      return ok;
+    }
 
-    inline bool empty() { return f->empty(); }
-    inline bool available(unsigned int k) const { return f->available(k); }
-    inline unsigned int size() const { return f->size(); }
-    inline unsigned int num_free() const { return f->num_free(); }
+    inline bool empty() { return dyn() ? f->empty() : sf.empty(); }
+    inline bool available(unsigned int k) const { return dyn() ? f->available(k) : sf.available(k); }
+    inline unsigned int size() const { return dyn() ? f->size() : sf.size(); }
+    inline unsigned int num_free() const { return dyn() ? f->num_free() : sf.num_free(); }
 
     inline void reset() {
-      f->reset();
+      cur().reset();
       for (int i=0; i<(int)rSz; i++)
         write(rVal);
     }
 
-    inline const T &operator[](unsigned int pos) const { return f->operator_sb(pos, rVal); }
+    inline const T &operator[](unsigned int pos) const { return cur().operator_sb(pos, rVal); }
+
+    inline void read_n(T *p, unsigned int n) { stat_rd(n, false, true); if (dyn()) f->read_n(p, n); else sf.read_n(p, n); }
+    inline void write_n(const T *p, unsigned int n) { stat_wr(n, true); if (dyn()) f->write_n(p, n); else sf.write_n(p, n); trace_wr(p, n); }
+    inline const T *acquire_read(unsigned int k) { return dyn() ? f->acquire_read(k) : sf.acquire_read(k); }
+    inline void release_read(unsigned int k) { stat_rd(k, false, true); if (dyn()) f->release_read(k); else sf.release_read(k); }
+    inline T *acquire_write(unsigned int k) {
+      T *p = dyn() ? f->acquire_write(k) : sf.acquire_write(k);
+#ifdef AC_CHANNEL_TRACE
+      wp = p;
+#endif
+      return p;
+    }
+    inline void commit_write(unsigned int k) {
+#ifdef AC_CHANNEL_TRACE
+      trace_wr(wp, k);   // before the reader may see (and release) the entries
+#endif
+      stat_wr(k, true);
+      if (dyn()) f->commit_write(k); else sf.commit_write(k);
+    }
 
     void incr_size_call_count() { ++size_call_count; }
     int get_size_call_count() {
@@ -504,12 +1525,12 @@ private:
       typename std::deque<T>::iterator itr;
     };
     iterator begin() {
-      AC_CHANNEL_ASSERT(f->get_fifo_type() == fifo_ac_channel_type, ac_channel_exception::no_insert_defined_for_channel_type);
-      return iterator(get_fifo<fifo_ac_channel>().ch.begin());
+      AC_CHANNEL_ASSERT(!dyn(), ac_channel_exception::no_insert_defined_for_channel_type);
+      return iterator(sf.ch.begin());
     }
     void insert(iterator itr, const T& t) {
-      AC_CHANNEL_ASSERT(f->get_fifo_type() == fifo_ac_channel_type, ac_channel_exception::no_insert_defined_for_channel_type);
-      get_fifo<fifo_ac_channel>().ch.insert(itr.itr,t);
+      AC_CHANNEL_ASSERT(!dyn(), ac_channel_exception::no_insert_defined_for_channel_type);
+      sf.ch.insert(itr.itr,t);
     }
   };
   fifo chan;
@@ -540,6 +1561,12 @@ ac_channel<T>::ac_channel(int init, T val) : chan(init, val)
     write(val);
 }
 
+template <class T>
+ac_channel<T>::ac_channel(const ac_channel_depth &d) : chan()
+{
+  chan.set_depth(d.depth);
+}
+
 template<class T>
 inline std::ostream& operator<< (std::ostream& os, ac_channel<T> &a)
 {
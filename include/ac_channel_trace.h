@@ -0,0 +1,265 @@
+/**************************************************************************
+ *                                                                        *
+ *  Algorithmic C (tm) Datatypes                                          *
+ *                                                                        *
+ *  Software Version: 2025.4                                              *
+ *                                                                        *
+ *  Release Date    : Thu Dec 11 10:19:28 PST 2025                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 2025.4.1                                            *
+ *                                                                        *
+ *  Copyright 2025 Siemens                                                *
+ *                                                                        *
+ *                                                                        *
+ *                                                                        *
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      *
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   *
+ *  distributed under the License is distributed on an "AS IS" BASIS,     *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              *
+ *  See the License for the specific language governing permissions and   *
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+
+/*
+//  Source:         ac_channel_trace.h
+//  Description:    record the traffic of an ac_channel and replay it
+//
+//  Compile with -DAC_CHANNEL_TRACE (every translation unit). Recording a
+//  channel of the full model:
+//
+//    ac_channel<pix_t> pix;
+//    ac_channel_recorder<pix_t> rec(pix, "pix.actrace");  // until rec is destroyed
+//    ... run the model ...
+//
+//  Regressing one block against the captured traffic:
+//
+//    ac_channel_replayer<pix_t> in("pix.actrace");
+//    ac_channel_replayer<out_t> ref("out.actrace");
+//    while (in.replay(pix, 1024)) {       // feed the block in batches
+//      blk(pix, out);
+//      out_t o, r;
+//      while (out.nb_read(o))
+//        assert(ref.next(r) && o == r);
+//    }
+//
+//  A trace file holds a 16 byte header ("ACTR", version, element size,
+//  reserved, as little-endian 32 bit words) followed by the elements in write
+//  order, each in ac_trace_codec<T>::bytes bytes:
+//    - ac_int<W,S> and ac_fixed<W,...>: the W bits, little-endian, in (W+7)/8 bytes
+//    - other types: their object representation (trivially copyable types only)
+//  Specialize ac_trace_codec for structs of ac types (see the ac_int codec).
+*/
+
+#ifndef __AC_CHANNEL_TRACE_H
+#define __AC_CHANNEL_TRACE_H
+
+#ifndef AC_CHANNEL_TRACE
+#error "ac_channel_trace.h requires compiling with -DAC_CHANNEL_TRACE"
+#endif
+
+#include <ac_fixed.h>
+#include <ac_channel.h>
+#include <fstream>
+#include <string.h>
+#include <vector>
+#if __cplusplus > 199711L
+#include <type_traits>
+#endif
+
+#ifdef __AC_NAMESPACE
+namespace __AC_NAMESPACE {
+#endif
+
+template <class T>
+struct ac_trace_codec {
+#if __cplusplus > 199711L
+  static_assert(std::is_trivially_copyable<T>::value, "ac_trace_codec: specialize the codec for this type");
+#endif
+  enum { bytes = sizeof(T) };
+  static void encode(const T &t, unsigned char *p) { memcpy(p, &t, sizeof(T)); }
+  static void decode(const unsigned char *p, T &t) { memcpy(&t, p, sizeof(T)); }
+};
+
+template <int W, bool S>
+struct ac_trace_codec< ac_int<W,S> > {
+  enum { bytes = (W+7)/8 };
+  static void encode(const ac_int<W,S> &t, unsigned char *p) {
+    const ac_int<8*bytes,false> u = t;
+    for (int i=0; i<bytes; i++)
+      p[i] = (unsigned char) u.template slc<8>(8*i).to_uint();
+  }
+  static void decode(const unsigned char *p, ac_int<W,S> &t) {
+    ac_int<8*bytes,false> u = 0;
+    for (int i=0; i<bytes; i++)
+      u.set_slc(8*i, ac_int<8,false>(p[i]));
+    t = u;
+  }
+};
+
+template <int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+struct ac_trace_codec< ac_fixed<W,I,S,Q,O> > {
+  typedef ac_trace_codec< ac_int<W,S> > bits_codec;
+  enum { bytes = bits_codec::bytes };
+  static void encode(const ac_fixed<W,I,S,Q,O> &t, unsigned char *p) { bits_codec::encode(t.template slc<W>(0), p); }
+  static void decode(const unsigned char *p, ac_fixed<W,I,S,Q,O> &t) {
+    ac_int<W,S> b;
+    bits_codec::decode(p, b);
+    t.set_slc(0, b);
+  }
+};
+
+namespace ac_private {
+  enum { trace_version = 1, trace_header_bytes = 16, trace_chunk = 1024 };
+
+  inline void trace_put32(unsigned char *p, unsigned int v) {
+    for (int i=0; i<4; i++)
+      p[i] = (unsigned char) (v >> 8*i);
+  }
+  inline unsigned int trace_get32(const unsigned char *p) {
+    return p[0] | p[1] << 8 | p[2] << 16 | (unsigned int) p[3] << 24;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Class: ac_channel_recorder
+//   Appends every element written to the channel to a trace file
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+class ac_channel_recorder : public ac_channel_write_observer<T> {
+  typedef ac_trace_codec<T> codec;
+public:
+  ac_channel_recorder(ac_channel<T> &c, const char *file)
+    : ch(c), os(file, std::ios::out | std::ios::binary | std::ios::trunc), buf(ac_private::trace_chunk * codec::bytes), pos(0), n(0)
+  {
+    AC_ASSERT(os.good(), "ac_channel_recorder: cannot open the trace file");
+    unsigned char h[ac_private::trace_header_bytes];
+    memcpy(h, "ACTR", 4);
+    ac_private::trace_put32(h + 4, ac_private::trace_version);
+    ac_private::trace_put32(h + 8, codec::bytes);
+    ac_private::trace_put32(h + 12, 0);
+    os.write((const char *) h, sizeof(h));
+    ch.set_write_observer(this);
+  }
+  ~ac_channel_recorder() {
+    ch.set_write_observer(0);
+    flush();
+  }
+
+  void written(const T *p, unsigned int k) {
+    for (unsigned int i=0; i<k; i++) {
+      if (pos == buf.size())
+        flush();
+      codec::encode(p[i], &buf[pos]);
+      pos += codec::bytes;
+    }
+    n += k;
+  }
+
+  void flush() {
+    os.write((const char *) &buf[0], pos);
+    os.flush();
+    pos = 0;
+  }
+  // elements recorded so far
+  unsigned long long count() const { return n; }
+
+private:
+  ac_channel<T> &ch;
+  std::ofstream os;
+  std::vector<unsigned char> buf;
+  size_t pos;
+  unsigned long long n;
+
+  ac_channel_recorder(const ac_channel_recorder &);
+  ac_channel_recorder &operator=(const ac_channel_recorder &);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Class: ac_channel_replayer
+//   Reads back the elements of a trace file in order
+////////////////////////////////////////////////////////////////////////////////
+template <class T>
+class ac_channel_replayer {
+  typedef ac_trace_codec<T> codec;
+public:
+  explicit ac_channel_replayer(const char *file)
+    : is(file, std::ios::in | std::ios::binary), buf(ac_private::trace_chunk * codec::bytes), pos(0), len(0), left(0), total(0), blk(0)
+  {
+    AC_ASSERT(is.good(), "ac_channel_replayer: cannot open the trace file");
+    unsigned char h[ac_private::trace_header_bytes];
+    is.read((char *) h, sizeof(h));
+    AC_ASSERT(is.gcount() == (std::streamsize) sizeof(h) && !memcmp(h, "ACTR", 4) &&
+              ac_private::trace_get32(h + 4) == ac_private::trace_version, "ac_channel_replayer: not a trace file");
+    AC_ASSERT(ac_private::trace_get32(h + 8) == (unsigned int) codec::bytes, "ac_channel_replayer: element size does not match the trace file");
+    is.seekg(0, std::ios::end);
+    total = ((unsigned long long) is.tellg() - sizeof(h)) / codec::bytes;
+    is.seekg(sizeof(h), std::ios::beg);
+    left = total;
+  }
+
+  ~ac_channel_replayer() { delete [] blk; }
+
+  // elements in the file / not read yet
+  unsigned long long size() const { return total; }
+  unsigned long long remaining() const { return left; }
+
+  bool next(T &t) {
+    if (!left)
+      return false;
+    if (pos == len)
+      fill();
+    codec::decode(&buf[pos], t);
+    pos += codec::bytes;
+    left--;
+    return true;
+  }
+
+  // write up to max elements to the channel, return the number written
+  unsigned long long replay(ac_channel<T> &c, unsigned long long max = ~0ull) {
+    if (!blk)
+      blk = new T[ac_private::trace_chunk];
+    unsigned long long done = 0;
+    while (done < max && left) {
+      unsigned int k = 0;
+      while (k < (unsigned int) ac_private::trace_chunk && done + k < max && next(blk[k]))
+        k++;
+      c.write_n(blk, k);
+      done += k;
+    }
+    return done;
+  }
+
+private:
+  void fill() {
+    is.read((char *) &buf[0], buf.size());
+    len = (size_t) is.gcount() / codec::bytes * codec::bytes;
+    pos = 0;
+    AC_ASSERT(len, "ac_channel_replayer: truncated trace file");
+  }
+
+  std::ifstream is;
+  std::vector<unsigned char> buf;
+  size_t pos, len;
+  unsigned long long left, total;
+  T *blk;              // replay() batch
+
+  ac_channel_replayer(const ac_channel_replayer &);
+  ac_channel_replayer &operator=(const ac_channel_replayer &);
+};
+
+#ifdef __AC_NAMESPACE
+}
+#endif
+
+#endif // __AC_CHANNEL_TRACE_H
@@ -0,0 +1,268 @@
+/**************************************************************************
+ *                                                                        *
+ *  Algorithmic C (tm) Datatypes                                          *
+ *                                                                        *
+ *  Software Version: 2025.4                                              *
+ *                                                                        *
+ *  Release Date    : Thu Dec 11 10:19:28 PST 2025                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 2025.4.1                                            *
+ *                                                                        *
+ *  Copyright 2025 Siemens                                                *
+ *                                                                        *
+ *                                                                        *
+ *                                                                        *
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      *
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   *
+ *  distributed under the License is distributed on an "AS IS" BASIS,     *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              *
+ *  See the License for the specific language governing permissions and   *
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+
+/*
+//  Source:         ac_coroutine.h
+//  Description:    cooperative (C++20 coroutine) execution of ac_channel blocks
+//
+//  Block functions written as coroutines returning ac::task suspend on an
+//  empty channel instead of asserting read_from_empty_channel, so feedback
+//  loops need no hand-ordered calling sequence:
+//
+//    ac::task filter(ac_channel<int> &in, ac_channel<int> &out) {
+//      for (;;) {
+//        int x = co_await ac::co_read(in);     // suspends while 'in' is empty
+//        co_await ac::co_write(out, x + 1);    // suspends while 'out' is full
+//      }
+//    }
+//
+//    ac::co_dataflow df;
+//    df.block(source(c0));
+//    df.block(filter(c0, c1));
+//    df.block(sink(c1, c0));
+//    bool ok = df.run();
+//
+//  co_dataflow runs all blocks on the calling thread: each pass resumes every
+//  block whose awaited condition holds, until no block can make progress
+//  (every block has returned or waits on a channel). run() returns false when
+//  a block is left waiting on a full channel (see ac_channel::set_depth),
+//  true otherwise. An exception thrown by a block is rethrown by run().
+//  Blocks that are still suspended are destroyed with the co_dataflow.
+//
+//  co_read/co_write/co_peek await a channel; co_yield_now() just gives the
+//  other blocks a turn. A coroutine returning ac::task may also be awaited
+//  from another block (co_await helper(c)) and runs as part of it. Awaiting
+//  outside of co_dataflow::run() does not suspend: the channel access then
+//  behaves as a plain read/write. Apart from the coroutine frame of each
+//  block, execution does not allocate.
+*/
+
+#ifndef __AC_COROUTINE_H
+#define __AC_COROUTINE_H
+
+#ifndef __cplusplus
+# error C++ is required to include this header file
+#endif
+#if (__cplusplus < 202002L)
+#error Please use C++20 or a later standard for compilation.
+#endif
+
+#include <ac_channel.h>
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+#ifdef __AC_NAMESPACE
+namespace __AC_NAMESPACE {
+#endif
+
+namespace ac_private {
+  // condition a suspended block waits for
+  struct co_wait {
+    bool for_write;
+    co_wait(bool w) : for_write(w) {}
+    virtual bool ready() = 0;
+  };
+
+  struct co_proc {
+    std::coroutine_handle<> top;
+    std::coroutine_handle<> resume;   // innermost suspended coroutine
+    co_wait *w;
+  };
+
+  inline co_proc *&co_current() {
+    static thread_local co_proc *p = 0;
+    return p;
+  }
+
+  template<class W>
+  struct co_awaiter : co_wait {
+    co_awaiter(bool w) : co_wait(w) {}
+    bool await_ready() { return static_cast<W*>(this)->ready(); }
+    bool await_suspend(std::coroutine_handle<> h) {
+      co_proc *p = co_current();
+      if (!p)
+        return false;
+      p->resume = h;
+      p->w = this;
+      return true;
+    }
+  };
+}
+
+namespace ac {
+
+  class task {
+  public:
+    struct promise_type {
+      std::coroutine_handle<> cont;
+      std::exception_ptr error;
+
+      task get_return_object() { return task(handle::from_promise(*this)); }
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      struct final_awaiter {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+          return h.promise().cont ? h.promise().cont : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+      };
+      final_awaiter final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { error = std::current_exception(); }
+    };
+    typedef std::coroutine_handle<promise_type> handle;
+
+    task(task &&o) : h(o.h) { o.h = nullptr; }
+    ~task() { if (h) h.destroy(); }
+
+    // awaiting a task runs it to completion as part of the awaiting block
+    bool await_ready() { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) {
+      h.promise().cont = c;
+      return h;
+    }
+    void await_resume() {
+      if (h.promise().error)
+        std::rethrow_exception(h.promise().error);
+    }
+
+  private:
+    friend class co_dataflow;
+    explicit task(handle h_) : h(h_) {}
+    task(const task &);
+    task &operator=(const task &);
+    handle h;
+  };
+
+  template<class T>
+  struct co_read_awaiter : ac_private::co_awaiter<co_read_awaiter<T> > {
+    ac_channel<T> &c;
+    explicit co_read_awaiter(ac_channel<T> &c_) : ac_private::co_awaiter<co_read_awaiter<T> >(false), c(c_) {}
+    bool ready() { return c.available(1); }
+    T await_resume() { return c.read(); }
+  };
+
+  template<class T>
+  struct co_peek_awaiter : ac_private::co_awaiter<co_peek_awaiter<T> > {
+    ac_channel<T> &c;
+    explicit co_peek_awaiter(ac_channel<T> &c_) : ac_private::co_awaiter<co_peek_awaiter<T> >(false), c(c_) {}
+    bool ready() { return c.available(1); }
+    T await_resume() { return c.peek(); }
+  };
+
+  template<class T>
+  struct co_write_awaiter : ac_private::co_awaiter<co_write_awaiter<T> > {
+    ac_channel<T> &c;
+    const T &t;
+    co_write_awaiter(ac_channel<T> &c_, const T &t_) : ac_private::co_awaiter<co_write_awaiter<T> >(true), c(c_), t(t_) {}
+    bool ready() { return !c.depth() || c.size() < c.depth(); }
+    void await_resume() { c.write(t); }
+  };
+
+  struct co_yield_awaiter : ac_private::co_awaiter<co_yield_awaiter> {
+    co_yield_awaiter() : ac_private::co_awaiter<co_yield_awaiter>(false) {}
+    bool await_ready() { return false; }
+    bool ready() { return true; }
+    void await_resume() {}
+  };
+
+  template<class T>
+  co_read_awaiter<T> co_read(ac_channel<T> &c) { return co_read_awaiter<T>(c); }
+  template<class T>
+  co_peek_awaiter<T> co_peek(ac_channel<T> &c) { return co_peek_awaiter<T>(c); }
+  template<class T>
+  co_write_awaiter<T> co_write(ac_channel<T> &c, const T &t) { return co_write_awaiter<T>(c, t); }
+  inline co_yield_awaiter co_yield_now() { return co_yield_awaiter(); }
+
+  class co_dataflow {
+  public:
+    co_dataflow() {}
+    ~co_dataflow() {
+      for (unsigned i=0; i<blocks.size(); i++)
+        blocks[i].h.destroy();
+    }
+
+    void block(task &&t) {
+      block_t b;
+      b.h = t.h;
+      b.p.top = b.p.resume = t.h;
+      b.p.w = 0;
+      t.h = nullptr;
+      blocks.push_back(b);
+    }
+
+    bool run() {
+      ac_private::co_proc *outer = ac_private::co_current();
+      bool progress = true;
+      while (progress) {
+        progress = false;
+        for (unsigned i=0; i<blocks.size(); i++) {
+          ac_private::co_proc &p = blocks[i].p;
+          if (p.top.done() || (p.w && !p.w->ready()))
+            continue;
+          p.w = 0;
+          ac_private::co_current() = &p;
+          p.resume.resume();
+          ac_private::co_current() = outer;
+          progress = true;
+          if (p.top.done() && blocks[i].h.promise().error)
+            std::rethrow_exception(blocks[i].h.promise().error);
+        }
+      }
+      for (unsigned i=0; i<blocks.size(); i++) {
+        const ac_private::co_proc &p = blocks[i].p;
+        if (!p.top.done() && p.w && p.w->for_write)
+          return false;
+      }
+      return true;
+    }
+
+  private:
+    struct block_t {
+      task::handle h;
+      ac_private::co_proc p;
+    };
+
+    co_dataflow(const co_dataflow &);
+    co_dataflow &operator=(const co_dataflow &);
+
+    std::vector<block_t> blocks;
+  };
+}
+
+#ifdef __AC_NAMESPACE
+}
+#endif
+
+#endif // __AC_COROUTINE_H
@@ -0,0 +1,383 @@
+/**************************************************************************
+ *                                                                        *
+ *  Algorithmic C (tm) Datatypes                                          *
+ *                                                                        *
+ *  Software Version: 2025.4                                              *
+ *                                                                        *
+ *  Release Date    : Thu Dec 11 10:19:28 PST 2025                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 2025.4.1                                            *
+ *                                                                        *
+ *  Copyright 2025 Siemens                                                *
+ *                                                                        *
+ *                                                                        *
+ *                                                                        *
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      *
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   *
+ *  distributed under the License is distributed on an "AS IS" BASIS,     *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              *
+ *  See the License for the specific language governing permissions and   *
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+
+/*
+//  Source:         ac_dataflow.h
+//  Description:    multi-threaded execution of ac_channel connected blocks
+//
+//  ac::dataflow runs the blocks of a C++ dataflow model concurrently on a
+//  pool of worker threads, instead of calling them one after another:
+//
+//    ac_channel<in_t>  c0;
+//    ac_channel<mid_t> c1;
+//    ac_channel<out_t> c2;
+//
+//    ac::dataflow df;
+//    df.channel(c0);                  // channels between blocks
+//    df.channel(c1, 1024);            // optional depth (default 64)
+//    df.channel(c2);
+//    df.block([&]{ source(c0); }, 1000);  // called 1000 times
+//    df.block([&]{ filter(c0, c1); });    // called until the graph drains
+//    df.block([&]{ sink(c1, c2); });
+//    bool ok = df.run();
+//
+//  channel() switches a channel to the lock-free ring backend of the given
+//  depth (contents are kept), so it may be written by one block thread and
+//  read by another. Every channel shared by two blocks must be registered.
+//  A channel must have a single writer block and a single reader block.
+//
+//  block(f, calls) registers a block function. It is called 'calls' times,
+//  or repeatedly until the graph is done when calls is 0.
+//
+//  run() starts one worker per hardware thread (at most one per block). A
+//  worker takes a ready block and calls it; a block blocked inside a call
+//  keeps its worker, and another worker is started when every worker is
+//  blocked while blocks are ready, so the pool grows up to one worker per
+//  block only for graphs that need it. Successive calls of a block may run
+//  on different threads.
+//
+//  Inside a block, a blocking read/peek on an empty channel (or write on a
+//  full one) waits for the other side instead of asserting
+//  read_from_empty_channel: it spins briefly, then sleeps until a channel
+//  transaction of another block notifies it. run() returns when every block
+//  has either made its calls or is waiting on an empty channel while all
+//  registered channels are empty; waiting blocks are then unwound (their
+//  pending call is abandoned). It returns false when the graph is stopped
+//  with a block waiting on a full channel, which no other block can drain
+//  (see ac_channel::set_depth), true otherwise. An exception thrown by a
+//  block stops the graph and is rethrown by run().
+//
+//  Channels written by the testbench before run() and read after it can be
+//  registered too; their contents at run() return are whatever the graph
+//  left in them.
+*/
+
+#ifndef __AC_DATAFLOW_H
+#define __AC_DATAFLOW_H
+
+#ifndef __cplusplus
+# error C++ is required to include this header file
+#endif
+#if (__cplusplus < 201103L)
+#error Please use C++11 or a later standard for compilation.
+#endif
+
+#include <ac_channel.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __AC_NAMESPACE
+namespace __AC_NAMESPACE {
+#endif
+
+namespace ac {
+
+  class dataflow {
+  public:
+    dataflow() : n_target(0), n_workers(0), n_idle(0), n_waiting(0), n_blocked(0), n_wblocked(0),
+                 n_finished(0), n_ready(0), n_sleeping(0), epoch(0), done(false), deadlock(false) {}
+
+    template<class T>
+    void channel(ac_channel<T> &c, unsigned int depth = 64) {
+      c.use_ring_buffer(depth);
+      ac_channel<T> *p = &c;
+      empty_checks.push_back([p]() { return p->debug_size() == 0; });
+    }
+
+    void block(const std::function<void()> &f, unsigned long calls = 0) {
+      blocks.push_back(block_t(f, calls));
+    }
+
+    bool run() {
+      n_idle = 0;
+      n_waiting = 0;
+      n_blocked = 0;
+      n_wblocked = 0;
+      n_finished = 0;
+      n_sleeping = 0;
+      done = false;
+      deadlock = false;
+      error = std::exception_ptr();
+      ready.clear();
+      for (unsigned i=0; i<blocks.size(); i++) {
+        blocks[i].made = 0;
+        ready.push_back(i);
+      }
+      n_ready = ready.size();
+      n_target = std::thread::hardware_concurrency();
+      if (!n_target)
+        n_target = 1;
+      if (n_target > blocks.size())
+        n_target = blocks.size();
+      {
+        std::lock_guard<std::mutex> lk(m);
+        for (unsigned i=0; i<n_target; i++)
+          spawn();
+      }
+      // workers started by blocked ones are joined too: once the last
+      // listed worker is joined no worker is left to start another one
+      for (unsigned i=0; ; i++) {
+        std::thread t;
+        {
+          std::lock_guard<std::mutex> lk(m);
+          if (i == workers.size())
+            break;
+          t.swap(workers[i]);
+        }
+        t.join();
+      }
+      workers.clear();
+      if (error)
+        std::rethrow_exception(error);
+      return !deadlock;
+    }
+
+  private:
+    struct block_t {
+      std::function<void()> f;
+      unsigned long calls;
+      unsigned long made;
+      block_t(const std::function<void()> &f_, unsigned long calls_) : f(f_), calls(calls_), made(0) {}
+    };
+
+    enum { quantum = 64 };
+
+    // thrown by wait() to unwind a block that is blocked when the graph is done
+    struct stop {};
+
+    class worker_scheduler : public ac_channel_scheduler {
+      dataflow &df;
+      unsigned int spins;
+      bool announced;
+      unsigned long seen;
+    public:
+      worker_scheduler(dataflow &df_) : df(df_), spins(0), announced(false), seen(0) {}
+      // A blocked call spins, then announces that it is going to sleep and
+      // returns once so the channel is tested again: a transaction made
+      // before the announcement is seen by that test, one made after it
+      // notifies (a new epoch). The next wait() tests again when there was
+      // one, else the call is blocked until a block that is not blocked
+      // makes a transaction, and it sleeps until a notification.
+      void wait(bool for_write) {
+        if (++spins < 64) {
+          std::this_thread::yield();
+          return;
+        }
+        std::unique_lock<std::mutex> lk(df.m);
+        if (df.done)
+          throw stop();
+        if (!announced) {
+          announced = true;
+          seen = df.epoch;
+          df.n_sleeping++;
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          return;
+        }
+        if (df.epoch != seen) {
+          announced = false;
+          spins = 0;
+          return;
+        }
+        if (for_write)
+          df.n_wblocked++;
+        else
+          df.n_blocked++;
+        df.check_done();
+        // the call keeps this worker: start another one when every worker
+        // is blocked and blocks are ready to run
+        df.n_waiting++;
+        if (df.n_waiting == df.n_workers && !df.ready.empty())
+          df.spawn();
+        while (df.epoch == seen && !df.done)
+          df.cv.wait(lk);
+        df.n_waiting--;
+        if (for_write)
+          df.n_wblocked--;
+        else
+          df.n_blocked--;
+        announced = false;
+        spins = 0;
+        if (df.done)
+          throw stop();
+      }
+      // a new epoch releases every announced call, so n_sleeping only
+      // counts announcements made since the last notification
+      void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (df.n_sleeping.load(std::memory_order_relaxed)) {
+          {
+            std::lock_guard<std::mutex> lk(df.m);
+            df.epoch++;
+            df.n_sleeping = 0;
+          }
+          df.cv.notify_all();
+        }
+      }
+      // the call went on without sleeping
+      void end_wait() {
+        spins = 0;
+        if (announced) {
+          std::lock_guard<std::mutex> lk(df.m);
+          if (seen == df.epoch)
+            df.n_sleeping--;
+          announced = false;
+        }
+      }
+    };
+
+    // with m held
+    void check_done() {
+      if (n_blocked + n_wblocked + n_finished < blocks.size())
+        return;
+      // no block can make progress: a write deadlock when one waits on a write
+      if (n_wblocked) {
+        deadlock = true;
+        stop_all();
+        return;
+      }
+      // every block waits on a read or is finished, and no data is left in flight
+      for (unsigned i=0; i<empty_checks.size(); i++)
+        if (!empty_checks[i]())
+          return;
+      stop_all();
+    }
+
+    // with m held
+    void stop_all() {
+      done = true;
+      cv.notify_all();
+      work_cv.notify_all();
+    }
+
+    // with m held
+    void spawn() {
+      n_workers++;
+      workers.push_back(std::thread(&dataflow::worker, this));
+    }
+
+    // one call of a block, false when it was stopped or threw
+    bool call(block_t &b, worker_scheduler &sch) {
+      bool ok = false;
+      try {
+        b.f();
+        ok = true;
+      } catch (stop &) {
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(m);
+        if (!error)
+          error = std::current_exception();
+        stop_all();
+      }
+      sch.end_wait();
+      return ok;
+    }
+
+    // Workers take ready blocks and call them, keeping a block for 'quantum'
+    // calls, or longer while no other one is ready. A block goes back to the
+    // ready queue until it has made its calls. Workers started for blocked
+    // ones exit when there is nothing to run.
+    void worker() {
+      worker_scheduler sch(*this);
+      ac_channel_scheduler::current() = &sch;
+      std::unique_lock<std::mutex> lk(m);
+      while (!done) {
+        if (ready.empty()) {
+          if (n_finished == blocks.size() || n_workers > n_target)
+            break;
+          n_idle++;
+          work_cv.wait(lk);
+          n_idle--;
+          continue;
+        }
+        block_t &b = blocks[ready.front()];
+        const unsigned int idx = ready.front();
+        ready.pop_front();
+        n_ready--;
+        lk.unlock();
+        bool more;
+        unsigned int n = 0;
+        do
+          more = call(b, sch) && (b.calls == 0 || ++b.made < b.calls);
+        while (more && !done && (++n < quantum || !n_ready.load(std::memory_order_relaxed)));
+        lk.lock();
+        if (more && !done) {
+          ready.push_back(idx);
+          n_ready++;
+          if (n_idle)
+            work_cv.notify_one();
+        } else {
+          n_finished++;
+          if (n_finished == blocks.size())
+            work_cv.notify_all();
+          check_done();
+        }
+      }
+      n_workers--;
+      lk.unlock();
+      ac_channel_scheduler::current() = 0;
+    }
+
+    std::vector<block_t> blocks;
+    std::vector<std::function<bool()> > empty_checks;
+    std::vector<std::thread> workers;
+    std::deque<unsigned int> ready;
+    std::mutex m;
+    std::condition_variable cv;       // blocked calls
+    std::condition_variable work_cv;  // idle workers
+    unsigned int n_target;
+    unsigned int n_workers;
+    unsigned int n_idle;
+    unsigned int n_waiting;
+    unsigned int n_blocked;
+    unsigned int n_wblocked;
+    unsigned int n_finished;
+    std::atomic<unsigned int> n_ready;
+    std::atomic<unsigned int> n_sleeping;
+    unsigned long epoch;
+    std::atomic<bool> done;
+    bool deadlock;
+    std::exception_ptr error;
+  };
+}
+
+#ifdef __AC_NAMESPACE
+}
+#endif
+
+#endif // __AC_DATAFLOW_H
@@ -0,0 +1,450 @@
+/**************************************************************************
+ *                                                                        *
+ *  Algorithmic C (tm) Datatypes                                          *
+ *                                                                        *
+ *  Software Version: 2025.4                                              *
+ *                                                                        *
+ *  Release Date    : Thu Dec 11 10:19:28 PST 2025                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 2025.4.1                                            *
+ *                                                                        *
+ *  Copyright 2025 Siemens                                                *
+ *                                                                        *
+ *                                                                        *
+ *                                                                        *
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      *
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   *
+ *  distributed under the License is distributed on an "AS IS" BASIS,     *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              *
+ *  See the License for the specific language governing permissions and   *
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+
+/*
+//  Source:         ac_fft.h
+//  Description:    bit-accurate fixed-point FFT on ac_complex<ac_fixed>
+//
+//  ac::fft<N, InT, TwT, OutT, Kernel, Scaling> computes the N point DFT
+//
+//      X[k] = sum_n x[n] * exp(-j*2*pi*n*k/N)   (forward)
+//      x[n] = sum_k X[k] * exp(+j*2*pi*n*k/N)   (inverse, no 1/N factor)
+//
+//  InT, TwT and OutT are ac_complex<ac_fixed<...> > types:
+//    InT   input samples
+//    TwT   twiddle factors. The twiddle ROM is computed at compile time in
+//          double precision and quantized once (AC_RND, AC_SAT) into TwT,
+//          so with TwT integer width 1 the value 1.0 saturates to
+//          1-2^-(WT-1), which is what most hardware ROMs store.
+//    OutT  output samples. It is also the type of the in-place stage
+//          storage, so the quantization and overflow modes of OutT are the
+//          per-stage rounding/overflow behavior of the transform.
+//
+//  Kernel:
+//    AC_FFT_RADIX2        N power of 2, log2(N) radix-2 DIT stages
+//    AC_FFT_RADIX4        N power of 4, log4(N) radix-4 DIT stages
+//    AC_FFT_SPLIT_RADIX   N power of 2, split-radix (radix-2/4) DIT
+//
+//  Scaling (applied before each stage result is quantized to OutT):
+//    AC_FFT_SCALE_NONE    no scaling, OutT must hold the log2(N) bits of growth
+//    AC_FFT_SCALE_STAGE   shift right by log2(radix) every stage (result is X/N).
+//                         OutT needs one guard bit (two for radix-4)
+//    AC_FFT_SCALE_BFP     block floating point: before each stage the block
+//                         headroom is measured and the stage shifts just
+//                         enough to guarantee no overflow
+//
+//  Every call returns the block exponent e such that the true transform
+//  is out * 2^e (0 for AC_FFT_SCALE_NONE, log2(N) for AC_FFT_SCALE_STAGE).
+//
+//  Usage:
+//    typedef ac_complex<ac_fixed<16,1,true> > in_t;
+//    typedef ac_complex<ac_fixed<18,2,true> > tw_t;
+//    typedef ac_complex<ac_fixed<18,2,true,AC_RND_CONV,AC_SAT> > out_t;
+//    in_t  x[256];
+//    out_t y[256];
+//    int e = ac::fft<256, in_t, tw_t, out_t, AC_FFT_RADIX4, AC_FFT_SCALE_BFP>::forward(x, y);
+//
+//    in_t  xb[64][256];                      // batch of frames
+//    out_t yb[64][256];
+//    int   eb[64];
+//    ac::fft<256, in_t, tw_t, out_t>::forward_batch(xb, yb, eb);
+//
+//  The batch functions run the transform stage by stage across all frames so
+//  each twiddle is fetched once per butterfly column rather than once per
+//  frame.
+*/
+
+#ifndef __AC_FFT_H
+#define __AC_FFT_H
+
+#ifndef __cplusplus
+# error C++ is required to include this header file
+#endif
+#if (defined(__GNUC__) && (__cplusplus < 201402L))
+#error Please use C++14 or a later standard for compilation.
+#endif
+
+#include <ac_complex.h>
+
+#ifdef __AC_NAMESPACE
+namespace __AC_NAMESPACE {
+#endif
+
+enum ac_fft_kernel { AC_FFT_RADIX2, AC_FFT_RADIX4, AC_FFT_SPLIT_RADIX };
+enum ac_fft_scaling { AC_FFT_SCALE_NONE, AC_FFT_SCALE_STAGE, AC_FFT_SCALE_BFP };
+
+namespace ac_private {
+
+  // compile-time sin/cos of (pi/2)*a/n for 0 <= a <= n/2 (|angle| <= pi/4)
+  constexpr double fft_sin_oct(long a, long n) {
+    const double x = 1.57079632679489661923 * (double) a / (double) n;
+    double x2 = x*x, term = x, sum = x;
+    for(int k=1; k < 14; k++) {
+      term *= -x2 / (double) ((2*k)*(2*k+1));
+      sum += term;
+    }
+    return sum;
+  }
+  constexpr double fft_cos_oct(long a, long n) {
+    const double x = 1.57079632679489661923 * (double) a / (double) n;
+    double x2 = x*x, term = 1.0, sum = 1.0;
+    for(int k=1; k < 14; k++) {
+      term *= -x2 / (double) ((2*k-1)*(2*k));
+      sum += term;
+    }
+    return sum;
+  }
+  // cos/sin of (pi/2)*a/n for 0 <= a <= n
+  constexpr double fft_cos_q(long a, long n) { return 2*a <= n ? fft_cos_oct(a, n) : fft_sin_oct(n-a, n); }
+  constexpr double fft_sin_q(long a, long n) { return 2*a <= n ? fft_sin_oct(a, n) : fft_cos_oct(n-a, n); }
+
+  // forward twiddles W_N^m = exp(-j*2*pi*m/N), m = 0 .. N-1
+  template<int N>
+  struct fft_twiddle_rom {
+    double re[N];
+    double im[N];
+    constexpr fft_twiddle_rom() : re(), im() {
+      for(long m=0; m < N; m++) {
+        // 2*pi*m/N = q*pi/2 + (pi/2)*a/N
+        const long q = (4*m) / N;
+        const long a = 4*m - q*N;
+        const double c = fft_cos_q(a, N);
+        const double s = fft_sin_q(a, N);
+        const double cr = q == 0 ? c : q == 1 ? -s : q == 2 ? -c : s;
+        const double sr = q == 0 ? s : q == 1 ?  c : q == 2 ? -s : -c;
+        re[m] = cr;
+        im[m] = -sr;
+      }
+    }
+  };
+
+  template<int N>
+  struct fft_log2 { enum { val = 1 + fft_log2<N/2>::val }; };
+  template<>
+  struct fft_log2<1> { enum { val = 0 }; };
+
+  // T with G more fraction bits: holds T values shifted right by up to G
+  // bits exactly, so that a scaled result is quantized to OutT only once
+  template<typename T, int G>
+  struct fft_exact {
+    typedef typename T::element_type E;
+    typedef ac_complex<ac_fixed<E::width + G, E::i_width, E::sign> > type;
+  };
+}
+
+namespace ac {
+
+  template<int N, typename InT, typename TwT, typename OutT,
+           ac_fft_kernel Kernel = AC_FFT_RADIX2, ac_fft_scaling Scaling = AC_FFT_SCALE_STAGE>
+  class fft {
+    enum {
+      log2N = ac_private::fft_log2<N>::val,
+      radix_bits = Kernel == AC_FFT_RADIX4 ? 2 : 1,
+      // bits of growth of one stage (component magnitude):
+      //   radix-2:  1+sqrt(2) < 4   radix-4:  1+3*sqrt(2) < 8   split L: 1+2*sqrt(2) < 4
+      guard_bits = Kernel == AC_FFT_RADIX4 ? 3 : 2,
+      max_shift = guard_bits + 1,
+      // largest block exponent difference of split-radix operands: every
+      // level shifts by at most max_shift (BFP) or by one (stage scaling)
+      align_bits = Scaling == AC_FFT_SCALE_BFP ? max_shift*log2N : Scaling == AC_FFT_SCALE_STAGE ? 1 : 0
+    };
+#if __cplusplus > 199711L
+    static_assert(N >= 2 && (N & (N-1)) == 0, "ac::fft: N must be a power of 2");
+    static_assert(Kernel != AC_FFT_RADIX4 || (log2N & 1) == 0, "ac::fft: AC_FFT_RADIX4 requires N to be a power of 4");
+#endif
+    typedef typename OutT::element_type out_elem_t;
+
+  public:
+    typedef InT  input_type;
+    typedef TwT  twiddle_type;
+    typedef OutT output_type;
+    static const int size = N;
+
+    // twiddle ROM: W_N^m for m = 0 .. N-1 (forward direction)
+    static const TwT &twiddle(int m) {
+      struct rom_t {
+        TwT w[N];
+        rom_t() {
+          static constexpr ac_private::fft_twiddle_rom<N> rom{};
+          typedef typename TwT::element_type tw_elem_t;
+          typedef ac_fixed<tw_elem_t::width, tw_elem_t::i_width, tw_elem_t::sign, AC_RND, AC_SAT> tw_q_t;
+          for(int m=0; m < N; m++)
+            w[m] = TwT(tw_q_t(rom.re[m]), tw_q_t(rom.im[m]));
+        }
+      };
+      static const rom_t rom;
+      return rom.w[m];
+    }
+
+    static int forward(const InT (&in)[N], OutT (&out)[N]) { return run(in, out, false); }
+    static int inverse(const InT (&in)[N], OutT (&out)[N]) { return run(in, out, true); }
+
+    template<int F>
+    static void forward_batch(const InT (&in)[F][N], OutT (&out)[F][N], int (&exp)[F]) { run_batch<F>(in[0], out[0], exp, false); }
+    template<int F>
+    static void inverse_batch(const InT (&in)[F][N], OutT (&out)[F][N], int (&exp)[F]) { run_batch<F>(in[0], out[0], exp, true); }
+
+    // pointer form: frames are consecutive blocks of N samples
+    static void run_batch(const InT *in, OutT *out, unsigned frames, int *exp, bool inv) {
+      const unsigned B = 8;
+      int e[B];
+      unsigned f = 0;
+      for(; f + B <= frames; f += B) {
+        run_batch<B>(in + f*N, out + f*N, e, inv);
+        for(unsigned k=0; k < B; k++)
+          if(exp) exp[f+k] = e[k];
+      }
+      for(; f < frames; f++) {
+        const int e1 = run_frame(in + f*N, out + f*N, inv);
+        if(exp) exp[f] = e1;
+      }
+    }
+
+    static int run(const InT (&in)[N], OutT (&out)[N], bool inv) { return run_frame(in, out, inv); }
+
+  private:
+    static int run_frame(const InT *in, OutT *out, bool inv) {
+      if(Kernel == AC_FFT_SPLIT_RADIX)
+        return split_radix<N>::run(in, 1, out, inv);
+      int e = 0;
+      run_batch<1>(in, out, &e, inv);
+      return e;
+    }
+
+    // iterative DIT over F frames, stage major so twiddles are shared between frames
+    template<int F>
+    static void run_batch(const InT *in, OutT *out, int *exp, bool inv) {
+      if(Kernel == AC_FFT_SPLIT_RADIX) {
+        for(int f=0; f < F; f++)
+          exp[f] = split_radix<N>::run(in + f*N, 1, out + f*N, inv);
+        return;
+      }
+      for(int f=0; f < F; f++) {
+        exp[f] = 0;
+        for(int n=0; n < N; n++)
+          out[f*N + digit_rev(n)] = in[f*N + n];
+      }
+      int s[F];
+      if(Kernel == AC_FFT_RADIX4) {
+        for(int q=1; q < N; q <<= 2) {
+          for(int f=0; f < F; f++) {
+            s[f] = stage_shift(out + f*N, N);
+            exp[f] += s[f];
+          }
+          const int tw_step = N/(4*q);
+          for(int k=0; k < q; k++) {
+            const TwT w1 = tw(k*tw_step, inv);
+            const TwT w2 = tw(2*k*tw_step, inv);
+            const TwT w3 = tw(3*k*tw_step, inv);
+            for(int f=0; f < F; f++)
+              for(int j=k; j < N; j += 4*q)
+                bfly4(out + f*N + j, q, w1, w2, w3, s[f], inv);
+          }
+        }
+      } else {
+        for(int h=1; h < N; h <<= 1) {
+          for(int f=0; f < F; f++) {
+            s[f] = stage_shift(out + f*N, N);
+            exp[f] += s[f];
+          }
+          const int tw_step = N/(2*h);
+          for(int k=0; k < h; k++) {
+            const TwT w = tw(k*tw_step, inv);
+            for(int f=0; f < F; f++)
+              for(int j=k; j < N; j += 2*h) {
+                if(k)
+                  bfly2(out[f*N + j], out[f*N + j + h], w, s[f]);
+                else
+                  bfly2(out[f*N + j], out[f*N + j + h], s[f]);
+              }
+          }
+        }
+      }
+    }
+
+    // W_N^-m is W_N^(N-m), so the inverse never negates a ROM entry
+    static const TwT &tw(int m, bool inv) {
+      return twiddle(inv && m ? N - m : m);
+    }
+
+    static int digit_rev(int n) {
+      int r = 0;
+      for(int b=0; b < log2N; b += radix_bits) {
+        r = (r << radix_bits) | (n & ((1 << radix_bits)-1));
+        n >>= radix_bits;
+      }
+      return r;
+    }
+
+    // redundant sign bits common to all components of the block
+    static int headroom(const OutT *x, int n) {
+      int h = out_elem_t::width - 1;
+      for(int i=0; i < n; i++) {
+        const int hr = x[i].r().leading_sign().to_int();
+        const int hi = x[i].i().leading_sign().to_int();
+        h = AC_MIN(h, AC_MIN(hr, hi));
+      }
+      return h;
+    }
+
+    static int stage_shift(const OutT *x, int n) {
+      if(Scaling == AC_FFT_SCALE_STAGE)
+        return radix_bits;
+      if(Scaling == AC_FFT_SCALE_BFP) {
+        const int h = headroom(x, n);
+        return h >= guard_bits ? 0 : guard_bits - h;
+      }
+      return 0;
+    }
+
+    // quantize x*2^-s to OutT: the shift is exact, the OutT conversion is
+    // the only rounding/overflow step
+    template<typename T2>
+    static OutT scale(const T2 &x, int s) {
+      typename ac_private::fft_exact<T2, max_shift>::type t = x;
+      if(s) {
+        t.r() >>= s;
+        t.i() >>= s;
+      }
+      return t;
+    }
+
+    // multiply by -j (forward) or +j (inverse)
+    template<typename T2>
+    static T2 rot(const T2 &x, bool inv) {
+      return inv ? T2(-x.i(), x.r()) : T2(x.i(), -x.r());
+    }
+
+    // trivial butterfly (W^0 = 1): no multiplier, no twiddle quantization
+    static void bfly2(OutT &a, OutT &b, int s) {
+      const OutT a0 = a;
+      a = scale(a0 + b, s);
+      b = scale(a0 - b, s);
+    }
+
+    static void bfly2(OutT &a, OutT &b, const TwT &w, int s) {
+      typedef typename OutT::template rt_T<TwT>::mult prod_t;
+      const prod_t p = b * w;
+      const OutT a0 = a;
+      a = scale(a0 + p, s);
+      b = scale(a0 - p, s);
+    }
+
+    static void bfly4(OutT *x, int q, const TwT &w1, const TwT &w2, const TwT &w3, int s, bool inv) {
+      typedef typename OutT::template rt_T<TwT>::mult prod_t;
+      typedef typename prod_t::template rt_T<prod_t>::plus sum_t;
+      const prod_t b0 = x[0];
+      const prod_t b1 = x[q]*w1;
+      const prod_t b2 = x[2*q]*w2;
+      const prod_t b3 = x[3*q]*w3;
+      const sum_t s02 = b0 + b2, d02 = b0 - b2;
+      const sum_t s13 = b1 + b3, d13 = rot(sum_t(b1 - b3), inv);
+      x[0]   = scale(s02 + s13, s);
+      x[q]   = scale(d02 + d13, s);
+      x[2*q] = scale(s02 - s13, s);
+      x[3*q] = scale(d02 - d13, s);
+    }
+
+    // recursive split-radix: out[0..M) = DFT_M(in[0], in[stride], ...), returns block exponent
+    template<int M, int Dummy = 0>
+    struct split_radix {
+      static int run(const InT *in, int stride, OutT *out, bool inv) {
+        OutT *u = out, *z = out + M/2, *z3 = out + 3*M/4;
+        const int eu = split_radix<M/2>::run(in, 2*stride, u, inv);
+        const int ez = split_radix<M/4>::run(in + stride, 4*stride, z, inv);
+        const int ez3 = split_radix<M/4>::run(in + 3*stride, 4*stride, z3, inv);
+        const int e = AC_MAX(eu, AC_MAX(ez, ez3));
+        int s = 0;
+        if(Scaling == AC_FFT_SCALE_STAGE)
+          s = 1;
+        else if(Scaling == AC_FFT_SCALE_BFP) {
+          const int h = AC_MIN(headroom(u, M/2) + e - eu,
+                        AC_MIN(headroom(z, M/4) + e - ez, headroom(z3, M/4) + e - ez3));
+          s = h >= guard_bits ? 0 : guard_bits - h;
+        }
+        typedef typename OutT::template rt_T<TwT>::mult prod_t;
+        typedef typename prod_t::template rt_T<prod_t>::plus sum_t;
+        typedef typename ac_private::fft_exact<sum_t, align_bits>::type sum_w_t;
+        const int tw_step = N/M;
+        for(int k=0; k < M/4; k++) {
+          sum_w_t u0 = u[k], u1 = u[k + M/4];
+          sum_w_t p1 = k ? prod_t(z[k] * tw(k*tw_step, inv)) : prod_t(z[k]);
+          sum_w_t p3 = k ? prod_t(z3[k] * tw(3*k*tw_step, inv)) : prod_t(z3[k]);
+          align(u0, e - eu);
+          align(u1, e - eu);
+          align(p1, e - ez);
+          align(p3, e - ez3);
+          const sum_w_t sp = p1 + p3;
+          const sum_w_t dp = rot(sum_w_t(p1 - p3), inv);
+          u[k]          = scale(u0 + sp, s);
+          z[k]          = scale(u0 - sp, s);
+          u[k + M/4]    = scale(u1 + dp, s);
+          z3[k]         = scale(u1 - dp, s);
+        }
+        return e + s;
+      }
+    };
+    template<int Dummy>
+    struct split_radix<2, Dummy> {
+      static int run(const InT *in, int stride, OutT *out, bool inv) {
+        out[0] = in[0];
+        out[1] = in[stride];
+        const int s = stage_shift(out, 2);
+        bfly2(out[0], out[1], s);
+        return s;
+      }
+    };
+    template<int Dummy>
+    struct split_radix<1, Dummy> {
+      static int run(const InT *in, int, OutT *out, bool) {
+        out[0] = in[0];
+        return 0;
+      }
+    };
+
+    template<typename T2>
+    static void align(T2 &x, int d) {
+      if(d) {
+        x.r() >>= d;
+        x.i() >>= d;
+      }
+    }
+  };
+
+}
+
+#ifdef __AC_NAMESPACE
+}
+#endif
+
+#endif // __AC_FFT_H
@@ -74,8 +74,8 @@
 #define AC_FIXED_VRA_ENABLE(a) (void(0))
 #else // VRA kicks in outside of HLS, if enabled.
 #ifdef AC_FIXED_VRA
-// Note that the value range analysis feature of AC Fixed is only available with a full
-// Catapult installation. vra_instr.h will be pre-included in ac_int.h if AC_FIXED_VRA is defined.
+// The value range analysis backend (vra_instr.h from a Catapult installation, or the built-in
+// ac_vra.h) will be pre-included in ac_int.h if AC_FIXED_VRA is defined.
 #define AC_FIXED_VRA_DISABLE(a) a.disable_vra()
 #define AC_FIXED_VRA_ENABLE(a) a.enable_vra()
 #else
@@ -105,6 +105,20 @@ namespace ac_private {
     };
   };
   // specializations after definition of ac_fixed
+
+  // A value converted to ac_fixed inside an operator: a temporary, not a variable for the
+  // built-in VRA backend (other backends see the conversion as before).
+  template<int W, bool S, typename T>
+  inline ac_fixed<W,W,S,AC_TRN,AC_WRAP> fixed_temp(const T &x) {
+  #if defined(__AC_FIXED_NUMERICAL_ANALYSIS_BASE) && defined(__AC_VRA_NATIVE)
+    ac_fixed<W,W,S,AC_TRN,AC_WRAP> r;
+    AC_FIXED_VRA_DISABLE(r);
+    r = x;
+    return r;
+  #else
+    return ac_fixed<W,W,S,AC_TRN,AC_WRAP>(x);
+  #endif
+  }
 }
 
 namespace ac {
@@ -189,7 +203,7 @@ __AC_FIXED_UTILITY_BASE
   inline const Base &base() const { return *this; }
 
   #ifdef __AC_FIXED_NUMERICAL_ANALYSIS_BASE
-  inline void this_update() {
+  inline __AC_VRA_INLINE void this_update() {
     #ifdef _INCLUDED_VRA_INSTR_H_
     int int_bits = ac_vra_ns::calc_int_bits(*this);
     double frac_value = ac_vra_ns::calc_frac_value(*this);
@@ -197,7 +211,11 @@ __AC_FIXED_UTILITY_BASE
     int int_bits = 0;
     double frac_value = 0.0;
     #endif
+    #ifdef __AC_VRA_NATIVE
+    NumBase::update(false, this->is_neg(), *this, int_bits, frac_value);
+    #else
     NumBase::update(false, this->is_neg(), this->to_double(), int_bits, frac_value);
+    #endif
   }
 
   #ifdef _INCLUDED_VRA_INSTR_H_
@@ -211,13 +229,17 @@ __AC_FIXED_UTILITY_BASE
   friend inline ac_fixed<W2,I2,S2,Q2,O2> value(ac_fixed<W2,I2,S2,Q2,O2>);
   #endif
 
+  #ifdef __AC_VRA_NATIVE
+  friend struct ac_vra_ns::access;
+  #endif
+
   template <class T_integ>
-  inline void init_with_integ_vra(const T_integ b) {
+  inline __AC_VRA_INLINE void init_with_integ_vra(const T_integ b) {
     static_assert(std::is_integral<T_integ>::value, "Input must be of an integral type.");
     constexpr bool S2 = std::is_signed<T_integ>::value;
     constexpr int W2 = std::numeric_limits<T_integ>::digits + int(S2);
 
-    ac_int<W2, S2> temp_ac_int = b;
+    ac_int<W2, S2> temp_ac_int = ac_private::int_temp<W2,S2>(b);
     ac_fixed<W2,W2,S2> f_op;
     f_op.base().operator =(temp_ac_int);
     cpy_from_fxpt(f_op);
@@ -405,7 +427,7 @@ private: // Don't let users use cpy_from_fxpt directly.
   // Putting the ac_fixed -> ac_fixed copying in a separate function to eliminate the need for "*this ="
   // assignments while dealing with integer -> fixed conversions and hence avoid issues with VRA.
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  inline void cpy_from_fxpt(const ac_fixed<W2,I2,S2,Q2,O2> &op) {
+  inline __AC_VRA_INLINE void cpy_from_fxpt(const ac_fixed<W2,I2,S2,Q2,O2> &op) {
     enum {N2=(W2+31+!S2)/32, F=W-I, F2=W2-I2, QUAN_INC = F2>F && !(Q==AC_TRN || (Q==AC_TRN_ZERO && !S2)) };
     bool carry = false;
 
@@ -469,12 +491,12 @@ private: // Don't let users use cpy_from_fxpt directly.
 
 public:
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  inline ac_fixed (const ac_fixed<W2,I2,S2,Q2,O2> &op) {
+  inline __AC_VRA_ENTRY ac_fixed (const ac_fixed<W2,I2,S2,Q2,O2> &op) {
     cpy_from_fxpt(op);
   }
 
   template<int W2, bool S2>
-  inline ac_fixed (const ac_int<W2,S2> &op) {
+  inline __AC_VRA_ENTRY ac_fixed (const ac_int<W2,S2> &op) {
     #ifdef _INCLUDED_VRA_INSTR_H_
     ac_fixed<W2,W2,S2> f_op(AC_VRA_STACK_NOT_TRACED);
     #else
@@ -522,18 +544,18 @@ public:
   }
 
   #ifdef __AC_FIXED_NUMERICAL_ANALYSIS_BASE
-  inline ac_fixed( bool b ) { init_with_integ_vra(b); }
-  inline ac_fixed( char b ) { init_with_integ_vra(b); }
-  inline ac_fixed( signed char b ) { init_with_integ_vra(b); }
-  inline ac_fixed( unsigned char b ) { init_with_integ_vra(b); }
-  inline ac_fixed( signed short b ) { init_with_integ_vra(b); }
-  inline ac_fixed( unsigned short b ) { init_with_integ_vra(b); }
-  inline ac_fixed( signed int b ) { init_with_integ_vra(b); }
-  inline ac_fixed( unsigned int b ) { init_with_integ_vra(b); }
-  inline ac_fixed( signed long b ) { init_with_integ_vra(b); }
-  inline ac_fixed( unsigned long b ) { init_with_integ_vra(b); }
-  inline ac_fixed( Slong b ) { init_with_integ_vra(b); }
-  inline ac_fixed( Ulong b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( bool b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( char b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( signed char b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( unsigned char b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( signed short b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( unsigned short b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( signed int b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( unsigned int b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( signed long b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( unsigned long b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( Slong b ) { init_with_integ_vra(b); }
+  inline __AC_VRA_ENTRY ac_fixed( Ulong b ) { init_with_integ_vra(b); }
   #else
   inline ac_fixed( bool b ) { *this = (ac_int<1,false>) b; }
   inline ac_fixed( char b ) { *this = (ac_int<8,true>) b; }
@@ -549,7 +571,7 @@ public:
   inline ac_fixed( Ulong b ) { *this = (ac_int<64,false>) b; }
   #endif
 
-  inline ac_fixed( double d ) {
+  inline __AC_VRA_ENTRY ac_fixed( double d ) {
     double di = ac_private::ldexpr<-(I+!S+((32-W-!S)&31))>(d);
     bool o, qb, r;
     bool neg_src = d < 0;
@@ -656,7 +678,7 @@ public:
 #endif
 
   // Explicit conversion functions to ac_int that captures all integer bits (bits are truncated)
-  inline ac_int<AC_MAX(I,1),S> to_ac_int() const { return ((ac_fixed<AC_MAX(I,1),AC_MAX(I,1),S>) *this).template slc<AC_MAX(I,1)>(0); }
+  inline ac_int<AC_MAX(I,1),S> to_ac_int() const { return ac_private::fixed_temp<AC_MAX(I,1),S>(*this).template slc<AC_MAX(I,1)>(0); }
 
   // Explicit conversion functions to C built-in types -------------
   inline int to_int() const { return ((I-W) >= 32) ? 0 : (signed int) to_ac_int(); }
@@ -1226,7 +1248,11 @@ public:
   // Bit and Slice Select -----------------------------------------------------
   template<int WS, int WX, bool SX>
   inline const ac_int<WS,S> slc(const ac_int<WX,SX> &index) const {
+    #if defined(__AC_INT_NUMERICAL_ANALYSIS_BASE) && defined(__AC_VRA_NATIVE)
+    ac_int<WS,S> r(AC_VRA_STACK_NOT_TRACED);
+    #else
     ac_int<WS,S> r;
+    #endif
     AC_ASSERT(index.to_int() >= 0, "Attempting to read slc with negative indeces");
     unsigned uindex = ac_int<WX-SX, false>(index).to_uint();
     Base::shift_r(uindex, r);
@@ -1239,7 +1265,11 @@ public:
 
   template<int WS>
   inline const ac_int<WS,S> slc(signed index) const {
+    #if defined(__AC_INT_NUMERICAL_ANALYSIS_BASE) && defined(__AC_VRA_NATIVE)
+    ac_int<WS,S> r(AC_VRA_STACK_NOT_TRACED);
+    #else
     ac_int<WS,S> r;
+    #endif
     AC_ASSERT(index >= 0, "Attempting to read slc with negative indeces");
     unsigned uindex = index & ((unsigned)~0 >> 1);
     Base::shift_r(uindex, r);
@@ -1251,7 +1281,11 @@ public:
   }
   template<int WS>
   inline const ac_int<WS,S> slc(unsigned uindex) const {
+    #if defined(__AC_INT_NUMERICAL_ANALYSIS_BASE) && defined(__AC_VRA_NATIVE)
+    ac_int<WS,S> r(AC_VRA_STACK_NOT_TRACED);
+    #else
     ac_int<WS,S> r;
+    #endif
     Base::shift_r(uindex, r);
     r.bit_adjust();
     #ifdef __AC_INT_NUMERICAL_ANALYSIS_BASE
@@ -1620,39 +1654,39 @@ inline std::ostream& operator << (std::ostream &os, const ac_fixed<W,I,S,Q,O> &x
 #define FX_BIN_OP_WITH_INT_2I(BIN_OP, C_TYPE, WI, SI)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
   inline ac_fixed<W,I,S,Q,O> operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE i_op) {  \
-    return op.operator BIN_OP (ac_int<WI,SI>(i_op));  \
+    return op.operator BIN_OP (ac_private::int_temp<WI,SI>(i_op));  \
   }
 
 #define FX_BIN_OP_WITH_INT(BIN_OP, C_TYPE, WI, SI, RTYPE)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
   inline typename ac_fixed<WI,WI,SI>::template rt<W,I,S>::RTYPE operator BIN_OP ( C_TYPE i_op, const ac_fixed<W,I,S,Q,O> &op) {  \
-    return ac_fixed<WI,WI,SI>(i_op).operator BIN_OP (op);  \
+    return ac_private::fixed_temp<WI,SI>(i_op).operator BIN_OP (op);  \
   } \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
   inline typename ac_fixed<W,I,S>::template rt<WI,WI,SI>::RTYPE operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE i_op) {  \
-    return op.operator BIN_OP (ac_fixed<WI,WI,SI>(i_op));  \
+    return op.operator BIN_OP (ac_private::fixed_temp<WI,SI>(i_op));  \
   }
 
 #define FX_REL_OP_WITH_INT(REL_OP, C_TYPE, W2, S2)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
   inline bool operator REL_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
-    return op.operator REL_OP (ac_fixed<W2,W2,S2>(op2));  \
+    return op.operator REL_OP (ac_private::fixed_temp<W2,S2>(op2));  \
   }  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
   inline bool operator REL_OP ( C_TYPE op2, const ac_fixed<W,I,S,Q,O> &op) {  \
-    return ac_fixed<W2,W2,S2>(op2).operator REL_OP (op);  \
+    return ac_private::fixed_temp<W2,S2>(op2).operator REL_OP (op);  \
   }
 
 #define FX_ASSIGN_OP_WITH_INT_2(ASSIGN_OP, C_TYPE, W2, S2)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
   inline ac_fixed<W,I,S,Q,O> &operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
-    return op.operator ASSIGN_OP (ac_fixed<W2,W2,S2>(op2));  \
+    return op.operator ASSIGN_OP (ac_private::fixed_temp<W2,S2>(op2));  \
   }
 
 #define FX_ASSIGN_OP_WITH_INT_2I(ASSIGN_OP, C_TYPE, W2, S2)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
   inline ac_fixed<W,I,S> operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
-    return op.operator ASSIGN_OP (ac_int<W2,S2>(op2));  \
+    return op.operator ASSIGN_OP (ac_private::int_temp<W2,S2>(op2));  \
   }
 
 #define FX_OPS_WITH_INT(C_TYPE, WI, SI) \
@@ -1714,13 +1748,13 @@ namespace ac {
 #define FX_BIN_OP_WITH_AC_INT_1(BIN_OP, RTYPE)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
   inline typename ac_fixed<WI,WI,SI>::template rt<W,I,S>::RTYPE operator BIN_OP ( const ac_int<WI,SI> &i_op, const ac_fixed<W,I,S,Q,O> &op) {  \
-    return ac_fixed<WI,WI,SI>(i_op).operator BIN_OP (op);  \
+    return ac_private::fixed_temp<WI,SI>(i_op).operator BIN_OP (op);  \
   }
 
 #define FX_BIN_OP_WITH_AC_INT_2(BIN_OP, RTYPE)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
   inline typename ac_fixed<W,I,S>::template rt<WI,WI,SI>::RTYPE operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &i_op) {  \
-    return op.operator BIN_OP (ac_fixed<WI,WI,SI>(i_op));  \
+    return op.operator BIN_OP (ac_private::fixed_temp<WI,SI>(i_op));  \
   }
 
 #define FX_BIN_OP_WITH_AC_INT(BIN_OP, RTYPE)  \
@@ -1730,17 +1764,17 @@ namespace ac {
 #define FX_REL_OP_WITH_AC_INT(REL_OP)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
   inline bool operator REL_OP ( const ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &op2) {  \
-    return op.operator REL_OP (ac_fixed<WI,WI,SI>(op2));  \
+    return op.operator REL_OP (ac_private::fixed_temp<WI,SI>(op2));  \
   }  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
   inline bool operator REL_OP ( ac_int<WI,SI> &op2, const ac_fixed<W,I,S,Q,O> &op) {  \
-    return ac_fixed<WI,WI,SI>(op2).operator REL_OP (op);  \
+    return ac_private::fixed_temp<WI,SI>(op2).operator REL_OP (op);  \
   }
 
 #define FX_ASSIGN_OP_WITH_AC_INT(ASSIGN_OP)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
   inline ac_fixed<W,I,S,Q,O> &operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &op2) {  \
-    return op.operator ASSIGN_OP (ac_fixed<WI,WI,SI>(op2));  \
+    return op.operator ASSIGN_OP (ac_private::fixed_temp<WI,SI>(op2));  \
   }  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
   inline ac_int<WI,SI> &operator ASSIGN_OP ( ac_int<WI,SI> &op, const ac_fixed<W,I,S,Q,O> &op2) {  \
@@ -1982,9 +2016,8 @@ namespace ac {
 }
 #endif
 
-#ifdef AC_FIXED_VRA
-// Note that the value range analysis feature of AC Fixed is only available with a full
-// Catapult installation.
+#if defined(AC_FIXED_VRA) && !defined(__AC_VRA_NATIVE)
+// Additional functions of the Catapult value range analysis backend (not used by ac_vra.h)
 #include "vra_instr_fixed_fns.h"
 #endif
 
@@ -0,0 +1,468 @@
+/**************************************************************************
+ *                                                                        *
+ *  Algorithmic C (tm) Datatypes                                          *
+ *                                                                        *
+ *  Software Version: 2025.4                                              *
+ *                                                                        *
+ *  Release Date    : Thu Dec 11 10:19:28 PST 2025                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 2025.4.1                                            *
+ *                                                                        *
+ *  Copyright 2025 Siemens                                                *
+ *                                                                        *
+ *                                                                        *
+ *                                                                        *
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      *
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   *
+ *  distributed under the License is distributed on an "AS IS" BASIS,     *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              *
+ *  See the License for the specific language governing permissions and   *
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+
+/*
+//  Source:         ac_fixed_math.h
+//  Description:    bit-accurate elementary functions on ac_fixed
+//
+//  ac::math provides reciprocal, sqrt, rsqrt, log2, exp2, sin/cos and atan2
+//  computed entirely in ac_fixed arithmetic, so results are reproducible bit
+//  for bit against a hardware implementation of the same kernel:
+//
+//    recip(x)        1/x
+//    sqrt(x)         square root, 0 for x <= 0
+//    rsqrt(x)        1/sqrt(x)
+//    log2(x)         base 2 logarithm
+//    exp2(x)         2^x
+//    sin(x), cos(x)  x in radians, sincos(x, s, c) returns both
+//    atan2(y, x)     angle of (x,y) in radians, in (-pi, pi]
+//
+//  Each function comes in two forms, both parameterized on the input and
+//  output ac_fixed types:
+//
+//    ac_fixed<16,4,true> x;
+//    ac_fixed<20,2,true,AC_RND,AC_SAT> y;
+//    ac::math::sqrt(x, y);                                      // output by reference
+//    y = ac::math::sqrt<ac_fixed<20,2,true,AC_RND,AC_SAT> >(x); // output type as template argument
+//
+//  Implementation:
+//    The argument is reduced to u in [0,1) (normalization with leading_sign
+//    for recip/sqrt/rsqrt/log2/atan2, integer/fraction split for exp2,
+//    quadrant reduction by a 128 bit 2/pi constant for sin/cos). u is split
+//    into an 8 bit segment index and a 32 bit offset t, and the function is
+//    evaluated as the quadratic c0 + t*(c1 + t*c2) whose coefficients come
+//    from a per-function table of 256 segments. The coefficients interpolate
+//    the function at the Chebyshev nodes of each segment; they are generated
+//    at compile time in double precision and quantized once (AC_RND) to 32
+//    fractional bits. Horner products are truncated to 32 fractional bits.
+//
+//  Accuracy:
+//    Every kernel (1/(1+u), sqrt, rsqrt, log2(1+u), 2^u, sin, cos, atan on
+//    the reduced range) has an absolute error below 2^-28. The final result is this kernel value scaled by a power of two
+//    (recip, sqrt, rsqrt, exp2) or offset by an integer (log2) or quadrant
+//    (sin, cos, atan2), then quantized once into the output type with its own
+//    quantization and overflow modes. So for an output with F fractional bits
+//    relative to the normalized result, F <= 26, the error is at most
+//    one output ulp with AC_TRN and half an ulp plus 2^-28 with AC_RND.
+//    Inputs with more than 40 significant bits are truncated to 40 bits
+//    after normalization.
+//
+//  Special inputs:
+//    recip(0), rsqrt(x <= 0)   maximum value of the output type
+//    log2(x <= 0)              minimum value of the output type
+//    sqrt(x < 0)               0
+//    atan2(0, 0)               0
+*/
+
+#ifndef __AC_FIXED_MATH_H
+#define __AC_FIXED_MATH_H
+
+#ifndef __cplusplus
+# error C++ is required to include this header file
+#endif
+#if (defined(__GNUC__) && (__cplusplus < 201402L))
+#error Please use C++14 or a later standard for compilation.
+#endif
+
+#include <ac_float.h>
+
+#ifdef __AC_NAMESPACE
+namespace __AC_NAMESPACE {
+#endif
+
+namespace ac_private {
+
+  // compile-time reference implementations (double precision) used only to
+  // generate the coefficient tables
+  constexpr double fxm_sqrt_d(double a) {
+    double r = a < 1.0 ? 1.0 : a;
+    for(int k=0; k < 64; k++)
+      r = 0.5 * (r + a / r);
+    return r;
+  }
+  // e^x for |x| <= 1
+  constexpr double fxm_exp_d(double x) {
+    double term = 1.0, sum = 1.0;
+    for(int k=1; k < 24; k++) {
+      term *= x / (double) k;
+      sum += term;
+    }
+    return sum;
+  }
+  // ln(m) for m in [1,2]: 2*atanh((m-1)/(m+1))
+  constexpr double fxm_ln_d(double m) {
+    const double z = (m - 1.0) / (m + 1.0);
+    const double z2 = z*z;
+    double term = z, sum = z;
+    for(int k=1; k < 40; k++) {
+      term *= z2;
+      sum += term / (double) (2*k+1);
+    }
+    return 2.0 * sum;
+  }
+  // sin/cos of x for |x| <= pi/2
+  constexpr double fxm_sin_d(double x) {
+    const double x2 = x*x;
+    double term = x, sum = x;
+    for(int k=1; k < 16; k++) {
+      term *= -x2 / (double) ((2*k)*(2*k+1));
+      sum += term;
+    }
+    return sum;
+  }
+  constexpr double fxm_cos_d(double x) {
+    const double x2 = x*x;
+    double term = 1.0, sum = 1.0;
+    for(int k=1; k < 16; k++) {
+      term *= -x2 / (double) ((2*k-1)*(2*k));
+      sum += term;
+    }
+    return sum;
+  }
+  // atan(x) for x in [0,1]: two argument halvings then the Taylor series
+  constexpr double fxm_atan_d(double x) {
+    for(int k=0; k < 2; k++)
+      x = x / (1.0 + fxm_sqrt_d(1.0 + x*x));
+    const double x2 = x*x;
+    double term = x, sum = x;
+    for(int k=1; k < 30; k++) {
+      term *= -x2;
+      sum += term / (double) (2*k+1);
+    }
+    return 4.0 * sum;
+  }
+
+  constexpr double fxm_ln2 = 0.69314718055994530942;
+  constexpr double fxm_pi = 3.14159265358979323846;
+
+  // functions of u in [0,1) tabulated by fxm_kernel
+  struct fxm_recip  { static constexpr double f(double u) { return 1.0 / (1.0 + u); } };
+  struct fxm_sqrt1  { static constexpr double f(double u) { return fxm_sqrt_d(1.0 + u); } };
+  struct fxm_sqrt2  { static constexpr double f(double u) { return fxm_sqrt_d(2.0 + 2.0*u); } };
+  struct fxm_rsqrt1 { static constexpr double f(double u) { return 1.0 / fxm_sqrt_d(1.0 + u); } };
+  struct fxm_rsqrt2 { static constexpr double f(double u) { return 1.0 / fxm_sqrt_d(2.0 + 2.0*u); } };
+  struct fxm_log2   { static constexpr double f(double u) { return fxm_ln_d(1.0 + u) / fxm_ln2; } };
+  struct fxm_exp2   { static constexpr double f(double u) { return fxm_exp_d(u * fxm_ln2); } };
+  struct fxm_sinq   { static constexpr double f(double u) { return fxm_sin_d(0.5 * fxm_pi * u); } };
+  struct fxm_cosq   { static constexpr double f(double u) { return fxm_cos_d(0.5 * fxm_pi * u); } };
+  struct fxm_atan   { static constexpr double f(double u) { return fxm_atan_d(u); } };
+
+  enum {
+    fxm_seg_bits = 8,                          // log2 of segments per table
+    fxm_t_bits = 32,                           // bits of the offset within a segment
+    fxm_u_bits = fxm_seg_bits + fxm_t_bits,    // reduced argument u in [0,1)
+    fxm_segs = 1 << fxm_seg_bits,
+    fxm_cf_bits = 32,                          // fractional bits of coefficients and kernel result
+    fxm_e_bits = 16                            // exponent width of the scaling step
+  };
+  typedef ac_fixed<fxm_u_bits,0,false> fxm_u_t;
+  typedef ac_fixed<fxm_t_bits,0,false> fxm_t_t;
+  typedef ac_fixed<fxm_cf_bits+3,3,true> fxm_coef_t;
+
+  // quadratic through the Chebyshev nodes of every segment, in the local
+  // variable t in [0,1):  p(t) = c0 + t*(c1 + t*c2)
+  template<typename Fn>
+  struct fxm_poly_rom {
+    double c0[fxm_segs];
+    double c1[fxm_segs];
+    double c2[fxm_segs];
+    constexpr fxm_poly_rom() : c0(), c1(), c2() {
+      const double h = 1.0 / (double) fxm_segs;
+      const double t0 = 0.5 - 0.43301270189221932338;   // (1 - cos(pi/6))/2
+      const double t1 = 0.5;
+      const double t2 = 0.5 + 0.43301270189221932338;
+      for(int i=0; i < fxm_segs; i++) {
+        const double y0 = Fn::f(h * (i + t0));
+        const double y1 = Fn::f(h * (i + t1));
+        const double y2 = Fn::f(h * (i + t2));
+        const double d01 = (y1 - y0) / (t1 - t0);
+        const double d12 = (y2 - y1) / (t2 - t1);
+        const double d012 = (d12 - d01) / (t2 - t0);
+        c2[i] = d012;
+        c1[i] = d01 - d012 * (t0 + t1);
+        c0[i] = y0 - d01 * t0 + d012 * t0 * t1;
+      }
+    }
+  };
+
+  template<typename Fn>
+  struct fxm_kernel {
+    struct rom_t {
+      fxm_coef_t c0[fxm_segs];
+      fxm_coef_t c1[fxm_segs];
+      fxm_coef_t c2[fxm_segs];
+      rom_t() {
+        static constexpr fxm_poly_rom<Fn> rom{};
+        typedef ac_fixed<fxm_coef_t::width, fxm_coef_t::i_width, true, AC_RND> coef_q_t;
+        for(int i=0; i < fxm_segs; i++) {
+          c0[i] = coef_q_t(rom.c0[i]);
+          c1[i] = coef_q_t(rom.c1[i]);
+          c2[i] = coef_q_t(rom.c2[i]);
+        }
+      }
+    };
+    static const rom_t &rom() {
+      static const rom_t r;
+      return r;
+    }
+    static fxm_coef_t eval(const fxm_u_t &u) {
+      const rom_t &r = rom();
+      const int seg = u.template slc<fxm_seg_bits>(fxm_t_bits).to_int();
+      fxm_t_t t;
+      t.set_slc(0, u.template slc<fxm_t_bits>(0));
+      fxm_coef_t p = r.c2[seg] * t;
+      p += r.c1[seg];
+      p = p * t;
+      p += r.c0[seg];
+      return p;
+    }
+  };
+
+  // |x| = (1+u)*2^e, returns e. zero is set when x == 0 (u and e are then 0)
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  inline int fxm_normalize(const ac_fixed<W,I,S,Q,O> &x, fxm_u_t &u, bool &zero) {
+    typedef ac_fixed<W,I,false> mag_t;
+    const mag_t mag = (S && x < 0) ? mag_t(-x) : mag_t(x);
+    ac_int<W,false> b = mag.template slc<W>(0);
+    bool all_zero;
+    const int ls = b.leading_sign(all_zero).to_int();
+    zero = all_zero;
+    b <<= ls;
+    ac_fixed<W,1,false> m;
+    m.set_slc(0, b);
+    u = m;           // AC_TRN/AC_WRAP: keeps the bits below the leading one
+    return all_zero ? 0 : I - 1 - ls;
+  }
+
+  // k*2^e quantized into the output type
+  template<int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void fxm_scale_out(const fxm_coef_t &k, int e, ac_fixed<WO,IO,SO,QO,OO> &y) {
+    const int e_lim = (1 << (fxm_e_bits-2));
+    e = e > e_lim ? e_lim : e < -e_lim ? -e_lim : e;
+    ac_float<fxm_coef_t::width, fxm_coef_t::i_width, fxm_e_bits> f(k, ac_int<fxm_e_bits,true>(e), false);
+    y = f.template convert_to_ac_fixed<WO,IO,SO,QO,OO>();
+  }
+
+  // 2/pi to 128 fractional bits
+  inline ac_int<128,false> fxm_two_over_pi() {
+    ac_int<128,false> c = 0;
+    c.set_slc(96, ac_int<32,false>(0xa2f9836eU));
+    c.set_slc(64, ac_int<32,false>(0x4e441529U));
+    c.set_slc(32, ac_int<32,false>(0xfc2757d1U));
+    c.set_slc( 0, ac_int<32,false>(0xf534ddc0U));
+    return c;
+  }
+}
+
+namespace ac {
+namespace math {
+
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void recip(const ac_fixed<W,I,S,Q,O> &x, ac_fixed<WO,IO,SO,QO,OO> &y) {
+    using namespace ac_private;
+    fxm_u_t u;
+    bool zero;
+    const int e = fxm_normalize(x, u, zero);
+    if(zero) {
+      y.template set_val<AC_VAL_MAX>();
+      return;
+    }
+    fxm_coef_t k = fxm_kernel<fxm_recip>::eval(u);
+    if(S && x < 0)
+      k = -k;
+    fxm_scale_out(k, -e, y);
+  }
+
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void sqrt(const ac_fixed<W,I,S,Q,O> &x, ac_fixed<WO,IO,SO,QO,OO> &y) {
+    using namespace ac_private;
+    fxm_u_t u;
+    bool zero;
+    const int e = fxm_normalize(x, u, zero);
+    if(zero || (S && x < 0)) {
+      y = 0;
+      return;
+    }
+    // odd exponents take the sqrt(2*(1+u)) table, e>>1 is floor(e/2)
+    const fxm_coef_t k = (e & 1) ? fxm_kernel<fxm_sqrt2>::eval(u) : fxm_kernel<fxm_sqrt1>::eval(u);
+    fxm_scale_out(k, e >> 1, y);
+  }
+
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void rsqrt(const ac_fixed<W,I,S,Q,O> &x, ac_fixed<WO,IO,SO,QO,OO> &y) {
+    using namespace ac_private;
+    fxm_u_t u;
+    bool zero;
+    const int e = fxm_normalize(x, u, zero);
+    if(zero || (S && x < 0)) {
+      y.template set_val<AC_VAL_MAX>();
+      return;
+    }
+    const fxm_coef_t k = (e & 1) ? fxm_kernel<fxm_rsqrt2>::eval(u) : fxm_kernel<fxm_rsqrt1>::eval(u);
+    fxm_scale_out(k, -(e >> 1), y);
+  }
+
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void log2(const ac_fixed<W,I,S,Q,O> &x, ac_fixed<WO,IO,SO,QO,OO> &y) {
+    using namespace ac_private;
+    fxm_u_t u;
+    bool zero;
+    const int e = fxm_normalize(x, u, zero);
+    if(zero || (S && x < 0)) {
+      y.template set_val<AC_VAL_MIN>();
+      return;
+    }
+    ac_fixed<fxm_cf_bits+fxm_e_bits, fxm_e_bits, true> r = e;
+    r += fxm_kernel<fxm_log2>::eval(u);
+    y = r;
+  }
+
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void exp2(const ac_fixed<W,I,S,Q,O> &x, ac_fixed<WO,IO,SO,QO,OO> &y) {
+    using namespace ac_private;
+    // x = n + f, n = floor(x), f in [0,1)
+    const ac_int<AC_MAX(I,1),S> n = x.to_ac_int();
+    const fxm_u_t u = x;
+    const int e_lim = (1 << (fxm_e_bits-2));
+    const int e = n > e_lim ? e_lim : n < -e_lim ? -e_lim : n.to_int();
+    fxm_scale_out(fxm_kernel<fxm_exp2>::eval(u), e, y);
+  }
+
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void sincos(const ac_fixed<W,I,S,Q,O> &x, ac_fixed<WO,IO,SO,QO,OO> &s, ac_fixed<WO,IO,SO,QO,OO> &c) {
+    using namespace ac_private;
+    // t = x*2/pi: 2 bits of quadrant and the reduced argument u. The constant
+    // keeps enough bits for the error on u to stay below 2^-(fxm_u_bits+2)
+    enum { CW = AC_MAX(I,0) + fxm_u_bits + 4 };
+#if __cplusplus > 199711L
+    static_assert(CW <= 128, "ac::math::sincos: input integer width too large for the 2/pi constant");
+#endif
+    ac_fixed<CW,0,false> k2pi;
+    k2pi.set_slc(0, fxm_two_over_pi().template slc<CW>(128-CW));
+    const ac_fixed<fxm_u_bits+2,2,false> qu = x * k2pi;
+    const int q = qu.template slc<2>(fxm_u_bits).to_int();
+    const fxm_u_t u = qu;
+    const fxm_coef_t sv = fxm_kernel<fxm_sinq>::eval(u);
+    const fxm_coef_t cv = fxm_kernel<fxm_cosq>::eval(u);
+    // sin(pi/2*(q+u)), cos(pi/2*(q+u))
+    const fxm_coef_t sr = (q & 1) ? cv : sv;
+    const fxm_coef_t cr = (q & 1) ? sv : cv;
+    s = (q & 2) ? fxm_coef_t(-sr) : sr;
+    c = ((q + 1) & 2) ? fxm_coef_t(-cr) : cr;
+  }
+
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void sin(const ac_fixed<W,I,S,Q,O> &x, ac_fixed<WO,IO,SO,QO,OO> &y) {
+    ac_fixed<WO,IO,SO,QO,OO> c;
+    sincos(x, y, c);
+  }
+
+  template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void cos(const ac_fixed<W,I,S,Q,O> &x, ac_fixed<WO,IO,SO,QO,OO> &y) {
+    ac_fixed<WO,IO,SO,QO,OO> s;
+    sincos(x, s, y);
+  }
+
+  template<int WY, int IY, bool SY, ac_q_mode QY, ac_o_mode OY,
+           int WX, int IX, bool SX, ac_q_mode QX, ac_o_mode OX,
+           int WO, int IO, bool SO, ac_q_mode QO, ac_o_mode OO>
+  inline void atan2(const ac_fixed<WY,IY,SY,QY,OY> &y, const ac_fixed<WX,IX,SX,QX,OX> &x, ac_fixed<WO,IO,SO,QO,OO> &a) {
+    using namespace ac_private;
+    enum { IM = AC_MAX(IY,IX), FM = AC_MAX(WY-IY,WX-IX) };
+    typedef ac_fixed<IM+FM,IM,false> mag_t;
+    const bool ny = SY && y < 0;
+    const bool nx = SX && x < 0;
+    const mag_t ay = ny ? mag_t(-y) : mag_t(y);
+    const mag_t ax = nx ? mag_t(-x) : mag_t(x);
+    const bool swap = ay > ax;
+    const mag_t mn = swap ? ax : ay;
+    const mag_t mx = swap ? ay : ax;
+    // r = mn/mx in [0,1] from the reciprocal kernel
+    fxm_u_t u_mx, u_mn;
+    bool z_mx, z_mn;
+    const int e_mx = fxm_normalize(mx, u_mx, z_mx);
+    const int e_mn = fxm_normalize(mn, u_mn, z_mn);
+    if(z_mx) {
+      a = 0;
+      return;
+    }
+    fxm_u_t r = 0;
+    if(!z_mn) {
+      ac_fixed<fxm_u_bits+1,1,false> m_mn = u_mn;
+      m_mn[fxm_u_bits] = 1;
+      const ac_fixed<fxm_cf_bits+2,1,false> rc = fxm_kernel<fxm_recip>::eval(u_mx);
+      ac_fixed<fxm_u_bits+2,2,false> p = m_mn * rc;      // (1+u_mn)/(1+u_mx) in (0.5,2)
+      const int sh = e_mx - e_mn;                         // >= 0 since mn <= mx
+      p >>= (sh > fxm_u_bits+2 ? fxm_u_bits+2 : sh);
+      if(p[fxm_u_bits])
+        r.template set_val<AC_VAL_MAX>();                 // mn == mx up to rounding
+      else
+        r = p;
+    }
+    const fxm_coef_t pi_2 = fxm_pi / 2;
+    const fxm_coef_t pi = fxm_pi;
+    fxm_coef_t t = fxm_kernel<fxm_atan>::eval(r);
+    if(swap)
+      t = pi_2 - t;
+    if(nx)
+      t = pi - t;
+    if(ny)
+      t = -t;
+    a = t;
+  }
+
+  // forms taking the output type as template argument
+  template<typename OutT, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  inline OutT recip(const ac_fixed<W,I,S,Q,O> &x) { OutT y; recip(x, y); return y; }
+  template<typename OutT, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  inline OutT sqrt(const ac_fixed<W,I,S,Q,O> &x) { OutT y; sqrt(x, y); return y; }
+  template<typename OutT, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  inline OutT rsqrt(const ac_fixed<W,I,S,Q,O> &x) { OutT y; rsqrt(x, y); return y; }
+  template<typename OutT, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  inline OutT log2(const ac_fixed<W,I,S,Q,O> &x) { OutT y; log2(x, y); return y; }
+  template<typename OutT, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  inline OutT exp2(const ac_fixed<W,I,S,Q,O> &x) { OutT y; exp2(x, y); return y; }
+  template<typename OutT, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  inline OutT sin(const ac_fixed<W,I,S,Q,O> &x) { OutT y; sin(x, y); return y; }
+  template<typename OutT, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  inline OutT cos(const ac_fixed<W,I,S,Q,O> &x) { OutT y; cos(x, y); return y; }
+  template<typename OutT, int WY, int IY, bool SY, ac_q_mode QY, ac_o_mode OY, int WX, int IX, bool SX, ac_q_mode QX, ac_o_mode OX>
+  inline OutT atan2(const ac_fixed<WY,IY,SY,QY,OY> &y, const ac_fixed<WX,IX,SX,QX,OX> &x) { OutT a; atan2(y, x, a); return a; }
+}
+}
+
+#ifdef __AC_NAMESPACE
+}
+#endif
+
+#endif // __AC_FIXED_MATH_H
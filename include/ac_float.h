@@ -490,6 +490,61 @@ public:
     return to_ac_fixed().to_ac_int();
   }
 
+  // Direct conversion to any ac_fixed: bit-exact with
+  //   ac_fixed<WFX,IFX,SFX,QFX,OFX>(to_ac_fixed())
+  // but the mantissa is shifted straight into a target sized word (plus
+  // rounding/overflow bits) instead of going through the full exponent
+  // range to_ac_fixed_t
+  template<int WFX, int IFX, bool SFX, ac_q_mode QFX, ac_o_mode OFX>
+  ac_fixed<WFX,IFX,SFX,QFX,OFX> convert_to_ac_fixed() const {
+    static const bool need_rnd_bit = QFX != AC_TRN;
+    static const bool need_rem_bits = need_rnd_bit & (QFX != AC_RND);
+    static const bool need_ovf = OFX != AC_WRAP;
+    static const int t_width = AC_MAX(W, WFX+!SFX) + need_rnd_bit + need_ovf;
+    typedef ac_int<t_width,true> t_t;
+    typedef ac_int<t_width+need_rem_bits,true> t2_t;
+
+    bool f_sign = m < 0;
+    t_t t = m.template slc<W>(0);
+    t <<= need_rnd_bit;
+    static const int lsb_src = I-W;
+    static const int lsb_trg = IFX-WFX;
+    int rshift = lsb_trg - lsb_src - e.to_int();
+
+    bool sticky_bit_rnd = false;
+    bool rshift_neg = rshift < 0;
+    if(need_rem_bits) {
+      t_t shifted_out_bits = t;
+      typedef ac_int< ac::template nbits< AC_MAX(lsb_trg - lsb_src - MIN_EXP,1) >::val, false> shift_ut;
+      shifted_out_bits &= ~(t_t(0).bit_complement() << (shift_ut) rshift);
+      sticky_bit_rnd = !!shifted_out_bits & !rshift_neg;
+    }
+    bool ovf = false;
+    if(need_ovf) {
+      t_t shifted_out_bits = t < 0 ? t_t(~t) : t;
+      // shift right by -rshift + 1
+      //   +1 is OK since added extra MSB
+      typedef ac_int< ac::template nbits< AC_MAX(-(lsb_trg - lsb_src - MAX_EXP + 1),1) >::val, false> shift_ut;
+      shifted_out_bits &= ~((t_t(0).bit_complement() >> 2) >> (shift_ut) ~rshift);
+      ovf = !!shifted_out_bits & rshift_neg;
+    }
+
+    t >>= rshift;
+
+    t[t_width-1] = t[t_width-1] ^ (ovf & (t[t_width-1] ^ f_sign));
+    t[t_width-2] = t[t_width-2] ^ (ovf & (t[t_width-2] ^ !f_sign));
+    t2_t t2 = t;
+    if(need_rem_bits) {
+      t2 <<= 1;
+      t2[0] = t2[0] | sticky_bit_rnd;
+    }
+
+    ac_fixed<WFX,WFX+need_rnd_bit+need_rem_bits,SFX,QFX,OFX> ri = t2;
+    ac_fixed<WFX,IFX,SFX,QFX,OFX> r = 0;
+    r.set_slc(0,ri.template slc<WFX>(0));
+    return r;
+  }
+
   // Explicit conversion functions to C built-in types -------------
   inline int to_int() const { return to_ac_int().to_int(); }
   inline unsigned to_uint() const { return to_ac_int().to_uint(); }
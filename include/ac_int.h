@@ -138,6 +138,7 @@
 // Refer to assert.h for an example of similar no-op usage.
 #define AC_INT_VRA_DISABLE(a) (void(0))
 #define AC_INT_VRA_ENABLE(a) (void(0))
+#define AC_VRA_NAME(a, n) (void(0))
 
 #else // VRA kicks in outside of HLS, if enabled.
 
@@ -151,13 +152,22 @@
 #endif
 
 #if defined (AC_INT_VRA) || defined(AC_FIXED_VRA)
-// Note that the value range analysis feature of AC Int and AC Fixed is only available with a full
-// Catapult installation.
+// The value range analysis backend is vra_instr.h from a Catapult installation, or the built-in
+// ac_vra.h when AC_VRA_BUILTIN is defined or vra_instr.h is not on the include path.
 
-// Regardless of whether you use ac_int or ac_fixed VRA, vra_instr.h will be included here to avoid
+// Regardless of whether you use ac_int or ac_fixed VRA, the backend will be included here to avoid
 // redefinition conflicts with ac_q_mode and ac_o_mode.
+#if !defined(AC_VRA_BUILTIN) && defined(__has_include)
+#if !__has_include("vra_instr.h")
+#define AC_VRA_BUILTIN
+#endif
+#endif
+#ifdef AC_VRA_BUILTIN
+#include <ac_vra.h>
+#else
 #include "vra_instr.h"
 #endif
+#endif
 
 #ifdef AC_INT_VRA
 #define AC_INT_VRA_DISABLE(a) a.disable_vra()
@@ -169,6 +179,21 @@
 #define AC_INT_VRA_ENABLE(a) (void(0))
 #endif
 
+// Names the site of variable a in the report of the built-in VRA backend (see ac_vra.h).
+#ifdef __AC_VRA_NATIVE
+#define AC_VRA_NAME(a, n) ac_vra_name(a, n)
+#else
+#define AC_VRA_NAME(a, n) (void(0))
+#endif
+
+#endif
+
+// Mark the members between user code and the VRA backend (ac_vra.h defines them to force inlining).
+#ifndef __AC_VRA_INLINE
+#define __AC_VRA_INLINE
+#endif
+#ifndef __AC_VRA_ENTRY
+#define __AC_VRA_ENTRY
 #endif
 
 #ifdef __AC_NAMESPACE
@@ -2040,36 +2065,54 @@ __AC_INT_UTILITY_BASE
 
   #ifdef __AC_INT_NUMERICAL_ANALYSIS_BASE
   template <int W2, bool S2>
-  inline void bit_adjust_vra(const ac_int<W2, S2> &orig_in, int int_bits) {
+  inline __AC_VRA_INLINE void bit_adjust_vra(const ac_int<W2, S2> &orig_in, int int_bits) {
     bit_adjust();
     bool overflow_seen = ovf_vra(orig_in);
+    #ifdef __AC_VRA_NATIVE
+    NumBase::update(orig_in, overflow_seen, int_bits);
+    #else
     NumBase::update(orig_in.to_double(), overflow_seen, int_bits);
+    #endif
   }
 
-  inline void bit_adjust_vra(const double orig_in, int int_bits) {
+  inline __AC_VRA_INLINE void bit_adjust_vra(const double orig_in, int int_bits) {
     bit_adjust();
     NumBase::update(orig_in, ovf_vra(orig_in, int_bits), int_bits);
   }
 
   template <class T>
-  inline void bit_adjust_vra(const T orig_in, int int_bits = 0) {
+  inline __AC_VRA_INLINE void bit_adjust_vra(const T orig_in, int int_bits = 0) {
     bit_adjust();
+    #ifdef __AC_VRA_NATIVE
+    NumBase::update(orig_in, ovf_vra(orig_in), int_bits);
+    #else
     double orig_double = (double)orig_in;
     NumBase::update(orig_double, ovf_vra(orig_in), int_bits);
+    #endif
   }
 
-  inline void this_update() {
+  inline __AC_VRA_INLINE void this_update() {
+    #ifdef __AC_VRA_NATIVE
+    NumBase::update(*this, false, ac_vra_ns::calc_int_bits(*this));
+    #else
     NumBase::update(this->to_double(), false, ac_vra_ns::calc_int_bits(*this));
+    #endif
   }
 
   inline static ac_int get_max_vra() {
     ac_int r(AC_VRA_STACK_NOT_TRACED);
+    #ifdef __AC_VRA_NATIVE
+    AC_INT_VRA_DISABLE(r);
+    #endif
     r.template set_val<AC_VAL_MAX>();
     return r;
   }
 
   inline static ac_int get_min_vra() {
     ac_int r(AC_VRA_STACK_NOT_TRACED);
+    #ifdef __AC_VRA_NATIVE
+    AC_INT_VRA_DISABLE(r);
+    #endif
     r.template set_val<AC_VAL_MIN>();
     return r;
   }
@@ -2251,6 +2294,10 @@ public:
   template <class T>
   friend int ac_vra_ns::calc_int_bits(const T op2);
 
+  #ifdef __AC_VRA_NATIVE
+  friend struct ac_vra_ns::access;
+  #endif
+
   // Make this a friend function so that you can access the ac_int constructor
   // that bypasses stack tracing.
   template<ac_special_val V, int W2, bool S2>
@@ -3410,32 +3457,48 @@ inline std::ostream& operator << (std::ostream &os, const ac_int<W,S> &x) {
   return os;
 }
 
+namespace ac_private {
+  // A C integer converted to ac_int for a mixed operator: a temporary, not a variable for the
+  // built-in VRA backend (other backends see the conversion as before).
+  template<int W, bool S, typename T>
+  inline ac_int<W,S> int_temp(const T &x) {
+  #if defined(__AC_INT_NUMERICAL_ANALYSIS_BASE) && defined(__AC_VRA_NATIVE)
+    ac_int<W,S> r;
+    AC_INT_VRA_DISABLE(r);
+    r = x;
+    return r;
+  #else
+    return ac_int<W,S>(x);
+  #endif
+  }
+}
+
 // Macros for Binary Operators with Integers --------------------------------------------
 
 #define BIN_OP_WITH_INT(BIN_OP, C_TYPE, WI, SI, RTYPE)  \
   template<int W, bool S> \
   inline typename ac_int<WI,SI>::template rt<W,S>::RTYPE operator BIN_OP ( C_TYPE i_op, const ac_int<W,S> &op) {  \
-    return ac_int<WI,SI>(i_op).operator BIN_OP (op);  \
+    return ac_private::int_temp<WI,SI>(i_op).operator BIN_OP (op);  \
   } \
   template<int W, bool S>   \
   inline typename ac_int<W,S>::template rt<WI,SI>::RTYPE operator BIN_OP ( const ac_int<W,S> &op, C_TYPE i_op) {  \
-    return op.operator BIN_OP (ac_int<WI,SI>(i_op));  \
+    return op.operator BIN_OP (ac_private::int_temp<WI,SI>(i_op));  \
   }
 
 #define REL_OP_WITH_INT(REL_OP, C_TYPE, W2, S2)  \
   template<int W, bool S>   \
   inline bool operator REL_OP ( const ac_int<W,S> &op, C_TYPE op2) {  \
-    return op.operator REL_OP (ac_int<W2,S2>(op2));  \
+    return op.operator REL_OP (ac_private::int_temp<W2,S2>(op2));  \
   }  \
   template<int W, bool S> \
   inline bool operator REL_OP ( C_TYPE op2, const ac_int<W,S> &op) {  \
-    return ac_int<W2,S2>(op2).operator REL_OP (op);  \
+    return ac_private::int_temp<W2,S2>(op2).operator REL_OP (op);  \
   }
 
 #define ASSIGN_OP_WITH_INT(ASSIGN_OP, C_TYPE, W2, S2)  \
   template<int W, bool S>   \
   inline ac_int<W,S> &operator ASSIGN_OP ( ac_int<W,S> &op, C_TYPE op2) {  \
-    return op.operator ASSIGN_OP (ac_int<W2,S2>(op2));  \
+    return op.operator ASSIGN_OP (ac_private::int_temp<W2,S2>(op2));  \
   }
 
 #define OPS_WITH_INT(C_TYPE, WI, SI) \
@@ -3804,9 +3867,8 @@ namespace ac {
 }
 #endif
 
-#ifdef AC_INT_VRA
-// Note that the value range analysis feature of AC Int is only available with a full
-// Catapult installation.
+#if defined(AC_INT_VRA) && !defined(__AC_VRA_NATIVE)
+// Additional functions of the Catapult value range analysis backend (not used by ac_vra.h)
 #include "vra_instr_int_fns.h"
 #endif
 
@@ -33,6 +33,32 @@
 
 /*
 //  Source:         ac_interleave_array.h
+//
+//  Arrays whose elements are distributed over InterleaveFactor banks along
+//  one dimension (the interleaved dimension, Dim, by default the last one).
+//  With BlockSize K (default 1) index x of that dimension is stored in
+//    bank  (x / K) % InterleaveFactor,  slot  x / (K*InterleaveFactor) * K + x % K
+//  i.e. cyclic interleaving for K == 1 and block-cyclic interleaving of
+//  blocks of K indices otherwise. Any factor is allowed: the divisions are by
+//  compile-time constants (shifts and masks for powers of two), and a bank
+//  holds the other dimensions times the ceil(extent / (K*factor))*K slots of
+//  the interleaved one, so a non power of two factor wastes no RAM.
+//
+//    ac_interleave_array_1D<int, 96, 3>          // a[i]: bank i%3
+//    ac_interleave_array_2D<int, 32, 24, 6>      // a[i][j]: bank j%6
+//    ac_interleave_array_2D<int, 32, 24, 4, 1>   // a[i][j]: bank i%4
+//    ac_interleave_array_3D<int, 3, 40, 40, 5, 2, 8>  // a[c][y][x]: bank (y/8)%5
+//
+//  The interleaved banks are declared element-major (ac_element_major): in C
+//  simulation consecutive addresses are then adjacent in host memory, while
+//  HLS sees the same separate banks as with the default layout.
+//
+//  A bank holds the elements of the other dimensions and the slots of the
+//  interleaved one flattened in row-major order, except for a 3D array with
+//  the default Dim and BlockSize and InterleaveFactor == ThirdDim (the
+//  configuration of earlier releases): its banks keep their earlier type,
+//  FirstDim rows of B[SecondDim], so that existing HLS directives naming them
+//  still apply.
 */
 
 #ifndef __AC_INTERLEAVE_ARRAY_H__
@@ -43,56 +69,59 @@
 #endif
 
 #include <ac_bank_array.h>
+#include <type_traits>
 
-template <typename B, size_t FirstDim, size_t InterleaveFactor>
+// bank and slot of index x of an interleaved dimension of extent N
+template <size_t N, size_t F, size_t K>
+struct ac_interleave_map
+{
+  static_assert(F >= 1 && K >= 1, "Error: interleaving factor and block size must be at least 1.");
+  static constexpr size_t Slots = (N + K*F - 1) / (K*F) * K;  // per bank
+  static size_t bank(size_t x) { return x / K % F; }
+  static size_t slot(size_t x) { return x / (K*F) * K + x % K; }
+};
+
+template <typename B, size_t FirstDim, size_t InterleaveFactor, size_t BlockSize = 1>
 class ac_interleave_array_1D
 {
+  typedef ac_interleave_map<FirstDim, InterleaveFactor, BlockSize> Map;
   public: // required public for SCVerify
-    static constexpr size_t SecondDim = (FirstDim/InterleaveFactor + (FirstDim%InterleaveFactor != 0) );
-    ac_bank_array_2D<B, InterleaveFactor, SecondDim> mem_bank;
+    static constexpr size_t SecondDim = Map::Slots;
+    ac_bank_array_2D<B, InterleaveFactor, SecondDim, ac_element_major> mem_bank;
     static const size_t W = FirstDim;
 
-    ac_interleave_array_1D () {
-      const size_t ComputedInterleaveFactor = 1UL<<BankBits(InterleaveFactor);
-      static_assert(ComputedInterleaveFactor == InterleaveFactor, "Error: interleaving is only possible when interleaving factor is power of two.");
-    }
-
-    static constexpr size_t BankBits(size_t n) {
-      return ((n) > 1 ? 1 + BankBits((n) >> 1) : 0);
-    }
-
     B &operator[](size_t idx) {
       AC_A_BANK_ARRAY_ASSERTION(idx < FirstDim);
-      size_t aidx = idx;
-      size_t bank_idx = aidx&(InterleaveFactor-1); // low order address bits select the bank
-      size_t block_idx = aidx>>(BankBits(InterleaveFactor));  // high order address bits select the blocks within the bank
-      AC_A_BANK_ARRAY_ASSERTION(block_idx < SecondDim);
-      return mem_bank[bank_idx][block_idx];
-   }
+      return mem_bank[Map::bank(idx)][Map::slot(idx)];
+    }
 
     const B &operator[](size_t idx) const {
       AC_A_BANK_ARRAY_ASSERTION(idx < FirstDim);
-      size_t aidx = idx;
-      size_t bank_idx = aidx&(InterleaveFactor-1); // low order address bits select the bank
-      size_t block_idx = aidx>>(BankBits(InterleaveFactor)); // high order address bits select the blocks within the bank
-      return mem_bank[bank_idx][block_idx];
+      return mem_bank[Map::bank(idx)][Map::slot(idx)];
     }
+
+    // element 'slot' of every bank (see ac_bank_array_2D::read_all_banks);
+    // with cyclic interleaving the addresses slot*InterleaveFactor + b
+    void read_all_banks(size_t slot, B (&out)[InterleaveFactor]) const { mem_bank.read_all_banks(slot, out); }
+    void read_all_banks(size_t slot, B (&out)[InterleaveFactor], const bool (&en)[InterleaveFactor]) const { mem_bank.read_all_banks(slot, out, en); }
+    void write_all_banks(size_t slot, const B (&in)[InterleaveFactor]) { mem_bank.write_all_banks(slot, in); }
+    void write_all_banks(size_t slot, const B (&in)[InterleaveFactor], const bool (&en)[InterleaveFactor]) { mem_bank.write_all_banks(slot, in, en); }
 };
 
-template <typename B, size_t FirstDim, size_t SecondDim, size_t InterleaveFactor>
+template <typename B, size_t FirstDim, size_t SecondDim, size_t InterleaveFactor, size_t Dim = 2, size_t BlockSize = 1>
 class ac_interleave_array_2D
 {
+  static_assert(Dim == 1 || Dim == 2, "Error: the interleaved dimension of a 2D array is 1 or 2.");
+  typedef ac_interleave_map<(Dim == 1 ? FirstDim : SecondDim), InterleaveFactor, BlockSize> Map;
+  static constexpr size_t E1 = Dim == 1 ? Map::Slots : FirstDim;
+  static constexpr size_t E2 = Dim == 2 ? Map::Slots : SecondDim;
   public: // required public for SCVerify
-    ac_bank_array_2D<B, InterleaveFactor, (FirstDim*SecondDim/InterleaveFactor)> mem_bank;
+    ac_bank_array_2D<B, InterleaveFactor, E1*E2, ac_element_major> mem_bank;
 
-    ac_interleave_array_2D () {
-      const size_t ComputedInterleaveFactor = 1UL<<BankBits(InterleaveFactor);
-      static_assert(ComputedInterleaveFactor == InterleaveFactor, "Error: interleaving is only possible when interleaving factor is power of two.");
-      //static_assert(InterleaveFactor <= SecondDim, "Error: interleaving factor cannot be higher than second dimension.");
-    }
-
-    static constexpr size_t BankBits(size_t n) {
-      return ((n) > 1 ? 1 + BankBits((n) >> 1) : 0);
+    // bank of [idx1][idx2] and its offset in the bank
+    static size_t bank(size_t idx1, size_t idx2) { return Map::bank(Dim == 1 ? idx1 : idx2); }
+    static size_t offset(size_t idx1, size_t idx2) {
+      return (Dim == 1 ? Map::slot(idx1) : idx1) * E2 + (Dim == 2 ? Map::slot(idx2) : idx2);
     }
 
     class SecondDimAccess{
@@ -104,7 +133,7 @@ class ac_interleave_array_2D
 
         B &operator[](size_t idx2) {
           AC_A_BANK_ARRAY_ASSERTION(idx2 < SecondDim);
-          return intMemObj.mem_bank[idx2][idxFirstDim];
+          return intMemObj.mem_bank[bank(idxFirstDim, idx2)][offset(idxFirstDim, idx2)];
         }
     };
 
@@ -122,7 +151,7 @@ class ac_interleave_array_2D
 
         const B &operator[](size_t idx2) const {
           AC_A_BANK_ARRAY_ASSERTION(idx2 < SecondDim);
-          return intMemObj.mem_bank[idx2][idxFirstDim];
+          return intMemObj.mem_bank[bank(idxFirstDim, idx2)][offset(idxFirstDim, idx2)];
         }
     };
 
@@ -130,25 +159,38 @@ class ac_interleave_array_2D
       AC_A_BANK_ARRAY_ASSERTION(idx1 < FirstDim);
       return ConstSecondDimAccess(*this, idx1);
     }
+
+    // element 'slot' of the interleaved dimension in every bank, at index idx
+    // of the other dimension; with cyclic interleaving of the last dimension
+    // the elements [idx][slot*InterleaveFactor + b]
+    void read_all_banks(size_t idx, B (&out)[InterleaveFactor], size_t slot = 0) const { mem_bank.read_all_banks(row(idx, slot), out); }
+    void read_all_banks(size_t idx, B (&out)[InterleaveFactor], const bool (&en)[InterleaveFactor], size_t slot = 0) const { mem_bank.read_all_banks(row(idx, slot), out, en); }
+    void write_all_banks(size_t idx, const B (&in)[InterleaveFactor], size_t slot = 0) { mem_bank.write_all_banks(row(idx, slot), in); }
+    void write_all_banks(size_t idx, const B (&in)[InterleaveFactor], const bool (&en)[InterleaveFactor], size_t slot = 0) { mem_bank.write_all_banks(row(idx, slot), in, en); }
+
+  private:
+    static size_t row(size_t idx, size_t slot) { return Dim == 1 ? slot * E2 + idx : idx * E2 + slot; }
 };
 
-template <typename B, size_t FirstDim, size_t SecondDim, size_t ThirdDim, size_t InterleaveFactor>
+template <typename B, size_t FirstDim, size_t SecondDim, size_t ThirdDim, size_t InterleaveFactor, size_t Dim = 3, size_t BlockSize = 1>
 class ac_interleave_array_3D
 {
+  static_assert(Dim >= 1 && Dim <= 3, "Error: the interleaved dimension of a 3D array is 1, 2 or 3.");
+  typedef ac_interleave_map<(Dim == 1 ? FirstDim : Dim == 2 ? SecondDim : ThirdDim), InterleaveFactor, BlockSize> Map;
+  static constexpr size_t E1 = Dim == 1 ? Map::Slots : FirstDim;
+  static constexpr size_t E2 = Dim == 2 ? Map::Slots : SecondDim;
+  static constexpr size_t E3 = Dim == 3 ? Map::Slots : ThirdDim;
+  // one element of the last dimension per bank: the bank type of earlier releases
+  typedef std::integral_constant<bool, Dim == 3 && BlockSize == 1 && InterleaveFactor == ThirdDim> RowBanks;
   public: // required public for SCVerify
-    // the following is valid only when InterleaveFactor == ThirdDim
-    // consider when it is not equal later
-    ac_bank_array_2D<B [SecondDim], InterleaveFactor, FirstDim> mem_bank;
-
-  public:
-    ac_interleave_array_3D () {
-      const size_t ComputedInterleaveFactor = 1UL<<BankBits(InterleaveFactor);
-      static_assert(ComputedInterleaveFactor == InterleaveFactor, "Error: interleaving is only possible when interleaving factor is power of two.");
-      static_assert(InterleaveFactor == ThirdDim, "Error: interleaving factor should be equal to the third dimension. Currently, only the last dimension is interleaved.");
-    }
-
-    static constexpr size_t BankBits(size_t n) {
-      return ((n) > 1 ? 1 + BankBits((n) >> 1) : 0);
+    typename std::conditional<RowBanks::value,
+                              ac_bank_array_2D<B [SecondDim], InterleaveFactor, FirstDim, ac_element_major>,
+                              ac_bank_array_2D<B, InterleaveFactor, E1*E2*E3, ac_element_major> >::type mem_bank;
+
+    // bank of [idx1][idx2][idx3] and its offset in the bank
+    static size_t bank(size_t idx1, size_t idx2, size_t idx3) { return Map::bank(Dim == 1 ? idx1 : Dim == 2 ? idx2 : idx3); }
+    static size_t offset(size_t idx1, size_t idx2, size_t idx3) {
+      return ((Dim == 1 ? Map::slot(idx1) : idx1) * E2 + (Dim == 2 ? Map::slot(idx2) : idx2)) * E3 + (Dim == 3 ? Map::slot(idx3) : idx3);
     }
 
     class ThirdDimAccess{
@@ -162,7 +204,7 @@ class ac_interleave_array_3D
 
         B &operator[](size_t idx3) {
           AC_A_BANK_ARRAY_ASSERTION(idx3 < ThirdDim);
-          return intMemObj.mem_bank[idx3][idxFirstDim][idxSecondDim];
+          return at<B>(intMemObj.mem_bank, idxFirstDim, idxSecondDim, idx3, RowBanks());
         }
     };
 
@@ -196,7 +238,7 @@ class ac_interleave_array_3D
 
         const B &operator[](size_t idx3) const {
           AC_A_BANK_ARRAY_ASSERTION(idx3 < ThirdDim);
-          return intMemObj.mem_bank[idx3][idxFirstDim][idxSecondDim];
+          return at<const B>(intMemObj.mem_bank, idxFirstDim, idxSecondDim, idx3, RowBanks());
         }
     };
 
@@ -218,7 +260,58 @@ class ac_interleave_array_3D
       AC_A_BANK_ARRAY_ASSERTION(idx1 < FirstDim);
       return ConstSecondDimAccess(*this, idx1);
     }
+
+    // element 'slot' of the interleaved dimension in every bank, at indices
+    // (idx_a, idx_b) of the other two dimensions (in order); with cyclic
+    // interleaving of the last dimension the elements [idx_a][idx_b][slot*InterleaveFactor + b]
+    void read_all_banks(size_t idx_a, size_t idx_b, B (&out)[InterleaveFactor], size_t slot = 0) const { get_all(mem_bank, idx_a, idx_b, slot, out, 0, RowBanks()); }
+    void read_all_banks(size_t idx_a, size_t idx_b, B (&out)[InterleaveFactor], const bool (&en)[InterleaveFactor], size_t slot = 0) const { get_all(mem_bank, idx_a, idx_b, slot, out, &en, RowBanks()); }
+    void write_all_banks(size_t idx_a, size_t idx_b, const B (&in)[InterleaveFactor], size_t slot = 0) { put_all(mem_bank, idx_a, idx_b, slot, in, 0, RowBanks()); }
+    void write_all_banks(size_t idx_a, size_t idx_b, const B (&in)[InterleaveFactor], const bool (&en)[InterleaveFactor], size_t slot = 0) { put_all(mem_bank, idx_a, idx_b, slot, in, &en, RowBanks()); }
+
+  private:
+    static size_t row(size_t idx_a, size_t idx_b, size_t slot) {
+      return Dim == 1 ? (slot * E2 + idx_a) * E3 + idx_b : Dim == 2 ? (idx_a * E2 + slot) * E3 + idx_b : (idx_a * E2 + idx_b) * E3 + slot;
+    }
+
+    // element [idx1][idx2][idx3] in the banks of earlier releases (bank idx3) or in flat banks
+    template <typename R, typename M>
+    static R &at(M &m, size_t idx1, size_t idx2, size_t idx3, std::true_type) { return m[idx3][idx1][idx2]; }
+    template <typename R, typename M>
+    static R &at(M &m, size_t idx1, size_t idx2, size_t idx3, std::false_type) { return m[bank(idx1, idx2, idx3)][offset(idx1, idx2, idx3)]; }
+
+    // every bank at (idx_a, idx_b, slot); en: the enabled banks, or null for all
+    typedef const bool (*Enables)[InterleaveFactor];
+    template <typename M>
+    static void get_all(const M &m, size_t idx_a, size_t idx_b, size_t slot, B (&out)[InterleaveFactor], Enables en, std::true_type) {
+      AC_A_BANK_ARRAY_ASSERTION(slot == 0);
+      #pragma hls_unroll yes
+      for (size_t b = 0; b < InterleaveFactor; b++)
+        if (!en || (*en)[b])
+          out[b] = m[b][idx_a][idx_b];
+    }
+    template <typename M>
+    static void get_all(const M &m, size_t idx_a, size_t idx_b, size_t slot, B (&out)[InterleaveFactor], Enables en, std::false_type) {
+      if (en)
+        m.read_all_banks(row(idx_a, idx_b, slot), out, *en);
+      else
+        m.read_all_banks(row(idx_a, idx_b, slot), out);
+    }
+    template <typename M>
+    static void put_all(M &m, size_t idx_a, size_t idx_b, size_t slot, const B (&in)[InterleaveFactor], Enables en, std::true_type) {
+      AC_A_BANK_ARRAY_ASSERTION(slot == 0);
+      #pragma hls_unroll yes
+      for (size_t b = 0; b < InterleaveFactor; b++)
+        if (!en || (*en)[b])
+          m[b][idx_a][idx_b] = in[b];
+    }
+    template <typename M>
+    static void put_all(M &m, size_t idx_a, size_t idx_b, size_t slot, const B (&in)[InterleaveFactor], Enables en, std::false_type) {
+      if (en)
+        m.write_all_banks(row(idx_a, idx_b, slot), in, *en);
+      else
+        m.write_all_banks(row(idx_a, idx_b, slot), in);
+    }
 };
 
 #endif
-
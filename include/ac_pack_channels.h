@@ -49,6 +49,10 @@
 // Usage with aggregate initialization:
 //  ac_pack_channels<uint8, 4> in{in0, in1, in2, in3};
 //  where in0, in1, in2, in3 are ac_channel of uint8
+//
+// Frames (one element per channel) are moved with read_all/write_all, or n at
+// a time with read_frames/write_frames. With a threaded channel backend
+// wait_all/wait_any block until all or any channel has data.
 
 #ifdef __AC_NAMESPACE
 namespace __AC_NAMESPACE {
@@ -72,48 +76,148 @@ namespace ac {
       }
 
       // Utility functions for channel packing
+      //   In C simulation the channels are visited through the bank tree at
+      //   compile time (ac_bank_array_visit) instead of indexing each one.
 
       // Check if all channels have data available
       inline bool all_available(unsigned int k = 1) {
+#ifndef __SYNTHESIS__
+        bool r = true;
+        ac_bank_array_visit(chan, [&](size_t, ac_channel<base> &c) { r = r && c.available(k); });
+        return r;
+#else
         #pragma hls_unroll yes
         for(size_t i = 0; i < size; i++) {
           if(!chan[i].available(k)) return false;
         }
         return true;
+#endif
       }
 
       // Check if any channel has data available
       inline bool any_available(unsigned int k = 1) {
+#ifndef __SYNTHESIS__
+        bool r = false;
+        ac_bank_array_visit(chan, [&](size_t, ac_channel<base> &c) { r = r || c.available(k); });
+        return r;
+#else
         #pragma hls_unroll yes
         for(size_t i = 0; i < size; i++) {
           if(chan[i].available(k)) return true;
         }
         return false;
+#endif
       }
 
       // Read from all channels into array
       inline void read_all(base (&data)[size]) {
+#ifndef __SYNTHESIS__
+        ac_bank_array_visit(chan, [&](size_t i, ac_channel<base> &c) { data[i] = c.read(); });
+#else
         #pragma hls_unroll yes
         for(size_t i = 0; i < size; i++) {
           data[i] = chan[i].read();
         }
+#endif
       }
 
       // Write data from array to each channel
       inline void write_all(const base (&data)[size]) {
+#ifndef __SYNTHESIS__
+        ac_bank_array_visit(chan, [&](size_t i, ac_channel<base> &c) { c.write(data[i]); });
+#else
         #pragma hls_unroll yes
         for(size_t i = 0; i < size; i++) {
           chan[i].write(data[i]);
         }
+#endif
+      }
+
+      // Read one element from every channel only if all of them have one
+      inline bool nb_read_all(base (&data)[size]) {
+        if(!all_available()) return false;
+        read_all(data);
+        return true;
       }
 
       // Transfer data between packed channels
       inline void transfer(ac_pack_channels& dst) {
+#ifndef __SYNTHESIS__
+        base data[size];
+        read_all(data);
+        dst.write_all(data);
+#else
         #pragma hls_unroll yes
         for(size_t i = 0; i < size; i++) {
           dst[i].write(chan[i].read());
         }
+#endif
+      }
+
+      // Read n frames (one element of every channel per frame). Each channel
+      // is accessed once for all n elements (acquire_read/release_read)
+      inline void read_frames(base (*frames)[size], unsigned int n) {
+#ifndef __SYNTHESIS__
+        ac_bank_array_visit(chan, [&](size_t i, ac_channel<base> &c) {
+          const base *p = c.acquire_read(n);
+          for(unsigned int f = 0; f < n; f++) frames[f][i] = p[f];
+          c.release_read(n);
+        });
+#else
+        for(unsigned int f = 0; f < n; f++) read_all(frames[f]);
+#endif
+      }
+
+      // Write n frames, one channel at a time (acquire_write/commit_write)
+      inline void write_frames(const base (*frames)[size], unsigned int n) {
+#ifndef __SYNTHESIS__
+        ac_bank_array_visit(chan, [&](size_t i, ac_channel<base> &c) {
+          base *p = c.acquire_write(n);
+          for(unsigned int f = 0; f < n; f++) p[f] = frames[f][i];
+          c.commit_write(n);
+        });
+#else
+        for(unsigned int f = 0; f < n; f++) write_all(frames[f]);
+#endif
+      }
+
+#ifdef __AC_CHANNEL_RING
+      // Blocking waits for threaded channel backends (ring or counting
+      // channels written by other threads): wait_all returns once every
+      // channel holds k entries, wait_any returns the lowest index of a
+      // channel holding k entries. Waiting goes through the installed
+      // ac_channel_scheduler, or yields the thread. Every channel must be
+      // thread_safe(): the deque backend cannot be written while it is polled.
+      inline void wait_all(unsigned int k = 1) {
+        check_thread_safe();
+        for(unsigned int spins = 0; !all_available(k); )
+          wait_ready(spins);
+      }
+
+      inline size_t wait_any(unsigned int k = 1) {
+        check_thread_safe();
+        for(unsigned int spins = 0; ; wait_ready(spins)) {
+          size_t r = size;
+          ac_bank_array_visit(chan, [&](size_t i, ac_channel<base> &c) {
+            if(r == size && c.available(k)) r = i;
+          });
+          if(r != size) return r;
+        }
+      }
+
+    private:
+      inline void check_thread_safe() {
+        ac_bank_array_visit(chan, [&](size_t, ac_channel<base> &c) {
+          AC_A_BANK_ARRAY_ASSERTION(c.thread_safe());
+        });
+      }
+      static inline void wait_ready(unsigned int &spins) {
+        if(ac_channel_scheduler *sch = ac_channel_scheduler::current())
+          sch->wait(false);
+        else if(++spins > 64)
+          std::this_thread::yield();
       }
+#endif
   };
 
   // Template aliases for common channel array sizes
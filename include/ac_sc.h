@@ -49,104 +49,188 @@ namespace __AC_NAMESPACE {
 #endif
 
 // Explicit conversion functions from ac to sc and viceversa
+//   In C simulation sc_bigint/sc_biguint values are read a digit at a time
+//   with concat_get_data (the copy used by SystemC concatenation) and written
+//   through an sc_bv filled a word at a time, instead of shifting the whole
+//   value per 32 bit chunk. sc_fixed/sc_ufixed have no concatenation support
+//   and are copied 32 bits at a time through part selects (range).
+//   Synthesis keeps the shift loops.
+namespace ac_private {
+  // the 32 bit chunk k of a W bit SystemC value (part select, top chunk partial)
+  template <int W, typename SC>
+  inline unsigned int sc_chunk(const SC &v, int k) {
+    const int lo = k*32;
+    return v.range(lo + 31 < W ? lo + 31 : W - 1, lo).to_uint();
+  }
+  template <int W, typename SC>
+  inline void sc_set_chunk(SC &v, int k, unsigned int d) {
+    const int lo = k*32;
+    v.range(lo + 31 < W ? lo + 31 : W - 1, lo) = d;
+  }
+  template <int W, typename SC>
+  inline ac_int<W,false> sc_to_bits(const SC &v) {
+    enum {N = (W+31)/32 };
+    ac_int<N*32,false> r = 0;
+    for(int i = 0; i < N; i++)
+      r.set_slc(i*32, ac_int<32,false>(sc_chunk<W>(v, i)));
+    return ac_int<W,false>(r);
+  }
+  template <int W, typename SC, bool S>
+  inline void bits_to_sc(const ac_int<W,S> &b, SC &v) {
+    enum {N = (W+31)/32 };
+    ac_int<N*32,false> u = b;
+    for(int i = 0; i < N; i++)
+      sc_set_chunk<W>(v, i, u.template slc<32>(i*32).to_uint());
+  }
+
+  // sc_signed/sc_unsigned: two's complement digits of BITS_PER_DIGIT bits
+  template <int W, typename SC>
+  inline ac_int<W,false> sc_int_to_bits(const SC &v) {
+    enum {D = BITS_PER_DIGIT, N = (W+D-1)/D };
+    sc_dt::sc_digit d[N+1] = {};
+    v.concat_get_data(d, 0);
+    ac_int<N*D,false> r = 0;
+    for(int i = 0; i < N; i++)
+      r.set_slc(i*D, ac_int<D,false>(d[i]));
+    return ac_int<W,false>(r);
+  }
+  template <int W, typename SC, bool S>
+  inline void bits_to_sc_int(const ac_int<W,S> &b, SC &v) {
+    enum {N = (W+31)/32 };
+    ac_int<N*32,false> u = ac_int<W,false>(b);
+    sc_dt::sc_bv<W> bv;
+    for(int i = 0; i < N; i++)
+      bv.set_word(i, u.template slc<32>(i*32).to_uint());
+    v = bv;
+  }
+}
+
 template <int W>
 ac_int<W, true> to_ac(const sc_dt::sc_bigint<W> &val){
+#ifdef __SYNTHESIS__
   enum {N = (W+31)/32 };
   sc_dt::sc_bigint<N*32> v = val;
   ac_int<N*32, true> r = 0;
-#ifdef __SYNTHESIS__
 #pragma hls_unroll y
-#endif
   for(int i = 0; i < N; i++) {
     r.set_slc(i*32, ac_int<32,true>(v.to_int()));
     v >>= 32;
   }
   return ac_int<W,true>(r);
+#else
+  return ac_int<W,true>(ac_private::sc_int_to_bits<W>(val));
+#endif
 }
 
 template <int W>
 ac_int<W, false> to_ac(const sc_dt::sc_biguint<W> &val){
+#ifdef __SYNTHESIS__
   enum {N = (W+31)/32 };
   sc_dt::sc_biguint<N*32> v = val;
   ac_int<N*32, true> r = 0;
-#ifdef __SYNTHESIS__
 #pragma hls_unroll y
-#endif
   for(int i = 0; i < N; i++) {
     r.set_slc(i*32, ac_int<32,true>(v.to_int()));
     v >>= 32;
   }
   return ac_int<W,false>(r);
+#else
+  return ac_private::sc_int_to_bits<W>(val);
+#endif
 }
 
 template <int W>
 sc_dt::sc_bigint<W> to_sc(const ac_int<W,true> &val) {
+#ifdef __SYNTHESIS__
   enum {N = (W+31)/32 };
   ac_int<N*32, true> v = val;
   sc_dt::sc_bigint<N*32> r;
-#ifdef __SYNTHESIS__
 #pragma hls_unroll y
-#endif
   for(int i = N-1; i >= 0; i--) {
     r <<= 32;
     r.range(31, 0) = (v.template slc<32>(i*32)).to_int();
   }
   return sc_dt::sc_bigint<W>(r);
+#else
+  sc_dt::sc_bigint<W> r;
+  ac_private::bits_to_sc_int(val, r);
+  return r;
+#endif
 }
 
 template <int W>
 sc_dt::sc_biguint<W> to_sc(const ac_int<W,false> &val) {
+#ifdef __SYNTHESIS__
   enum {N = (W+31)/32 };
   ac_int<N*32, true> v = val;
   sc_dt::sc_biguint<N*32> r;
-#ifdef __SYNTHESIS__
 #pragma hls_unroll y
-#endif
   for(int i = N-1; i >= 0; i--) {
     r <<= 32;
     r.range(31, 0) = (v.template slc<32>(i*32)).to_int();
   }
   return sc_dt::sc_biguint<W>(r);
+#else
+  sc_dt::sc_biguint<W> r;
+  ac_private::bits_to_sc_int(val, r);
+  return r;
+#endif
 }
 
 #ifdef SC_INCLUDE_FX
 template <int W, int I, sc_dt::sc_q_mode Q, sc_dt::sc_o_mode O, int nbits>
 ac_fixed<W,I, true> to_ac(const sc_dt::sc_fixed<W,I,Q,O,nbits> &val){
   ac_fixed<W,I,true> r = 0;
+#ifdef __SYNTHESIS__
   sc_dt::sc_fixed<W,W> fv;
   fv.range(W-1,0) = val.range(W-1,0);
   sc_dt::sc_bigint<W> v(fv);
   r.set_slc(0, to_ac(v));
+#else
+  r.set_slc(0, ac_private::sc_to_bits<W>(val));
+#endif
   return r;
 }
 
 template <int W, int I, sc_dt::sc_q_mode Q, sc_dt::sc_o_mode O, int nbits>
 ac_fixed<W,I, false> to_ac(const sc_dt::sc_ufixed<W,I,Q,O,nbits> &val){
   ac_fixed<W,I,false> r = 0;
+#ifdef __SYNTHESIS__
   sc_dt::sc_ufixed<W,W> fv;
   fv.range(W-1,0) = val.range(W-1,0);
   sc_dt::sc_biguint<W> v(fv);
   r.set_slc(0, to_ac(v));
+#else
+  r.set_slc(0, ac_private::sc_to_bits<W>(val));
+#endif
   return r;
 }
 
 template <int W, int I, ac_q_mode Q, ac_o_mode O>
 sc_dt::sc_fixed<W,I> to_sc(const ac_fixed<W,I,true,Q,O> &val) {
+  sc_dt::sc_fixed<W,I> r;
+#ifdef __SYNTHESIS__
   ac_int<W,true> v = val.template slc<W>(0);
   sc_dt::sc_bigint<W> i = to_sc(v);
   sc_dt::sc_fixed<W,W> f(i);
-  sc_dt::sc_fixed<W,I> r;
   r.range(W-1,0) = f.range(W-1,0);
+#else
+  ac_private::bits_to_sc(val.template slc<W>(0), r);
+#endif
   return r;
 }
 
 template <int W, int I, ac_q_mode Q, ac_o_mode O>
 sc_dt::sc_ufixed<W,I> to_sc(const ac_fixed<W,I,false,Q,O> &val) {
+  sc_dt::sc_ufixed<W,I> r;
+#ifdef __SYNTHESIS__
   ac_int<W,false> v = val.template slc<W>(0);
   sc_dt::sc_biguint<W> i = to_sc(v);
   sc_dt::sc_ufixed<W,W> f(i);
-  sc_dt::sc_ufixed<W,I> r;
   r.range(W-1,0) = f.range(W-1,0);
+#else
+  ac_private::bits_to_sc(val.template slc<W>(0), r);
+#endif
   return r;
 }
 #endif
@@ -33,7 +33,9 @@
 #pragma once
 
 #include <iostream>
+#include <type_traits>
 #include <ac_int.h>
+#include <ac_fixed.h>
 #include <ac_channel.h>
 #include <mc_scverify.h>
 #include <connections/marshaller.h>
@@ -61,19 +63,61 @@ bool ac_join_available(ac_channel<T_IN> ch_i[SIZE]) {
   }
 }
 
+//------------------------------------------------------------------------------
+// Bit vector conversion. ac_int, ac_fixed and C integral types are copied with
+// slc/set_slc; other types go through the Connections marshaller
+// (sc_lv/sc_biguint). A struct of such types can skip the marshaller by
+// specializing ac_split_join_bits with the field offsets, first field at bit 0
+// as in the marshaller:
+//
+//   template<> struct ac_split_join_bits<pix_t> {
+//     static const bool native = true;
+//     static void to_bv(const pix_t &p, ac_int<32,false> &v) {
+//       v.set_slc(0, p.r); v.set_slc(10, p.g); v.set_slc(20, p.b);
+//     }
+//     static void from_bv(const ac_int<32,false> &v, pix_t &p) {
+//       p.r = v.slc<10>(0); p.g = v.slc<10>(10); p.b = v.slc<12>(20);
+//     }
+//   };
+//------------------------------------------------------------------------------
+template<typename T>
+struct ac_split_join_bits {
+  static const bool native = false;
+};
+
+template<int W, bool S>
+struct ac_split_join_bits< ac_int<W,S> > {
+  static const bool native = true;
+  static void to_bv(const ac_int<W,S> &obj, ac_int<W,false> &vec) { vec = obj; }
+  static void from_bv(const ac_int<W,false> &vec, ac_int<W,S> &obj) { obj = vec; }
+};
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+struct ac_split_join_bits< ac_fixed<W,I,S,Q,O> > {
+  static const bool native = true;
+  static void to_bv(const ac_fixed<W,I,S,Q,O> &obj, ac_int<W,false> &vec) { vec = obj.template slc<W>(0); }
+  static void from_bv(const ac_int<W,false> &vec, ac_fixed<W,I,S,Q,O> &obj) { obj.set_slc(0, vec); }
+};
+
 template<typename T, int N>
 inline void type_to_bv(const T& obj, ac_int<N,false>& vec) {
-  vec = to_ac(sc_dt::sc_biguint<N>(Connections::convert_to_lv(obj)));
+  if constexpr (ac_split_join_bits<T>::native) {
+    ac_split_join_bits<T>::to_bv(obj, vec);
+  } else if constexpr (std::is_integral<T>::value) {
+    vec = obj;
+  } else {
+    vec = to_ac(sc_dt::sc_biguint<N>(Connections::convert_to_lv(obj)));
+  }
 }
 
 template<typename T, int N>
 inline void bv_to_type(const ac_int<N,false>& vec, T& obj)
 {
   using non_ref_T = typename std::remove_reference<T>::type;
-  if constexpr (std::is_same<T, ac_int<N,false> >::value) {
-    obj = vec;
-  } else if constexpr (std::is_same<T, ac_int<N,true> >::value) {
-    obj = vec;
+  if constexpr (ac_split_join_bits<non_ref_T>::native) {
+    ac_split_join_bits<non_ref_T>::from_bv(vec, obj);
+  } else if constexpr (std::is_integral<non_ref_T>::value) {
+    obj = (non_ref_T) vec.to_uint64();
   } else {
     obj = Connections::convert_from_lv<non_ref_T>(sc_dt::sc_lv<N>(to_sc(vec)));
   }
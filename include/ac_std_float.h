@@ -215,11 +215,22 @@ namespace ac {
   void fx_div_sim(ac_int<W,false> op1, ac_int<W,false> op2, ac_int<W+2,false> &quotient, bool &exact) {
     // need to compute extra rnd bit,
     //   +2 because we may need to shift left by 1 (mant divisor > mant dividend)
+    if(2*W+1 <= 64) {
+      // native division (float and narrower)
+      Ulong n = op1.to_uint64() << (W+1);
+      Ulong d = op2.to_uint64();
+      Ulong q = n / d;
+      quotient = q;
+      exact = q * d == n;
+      return;
+    }
     ac_int<2*W+1,false> op1_mi = op1;
     op1_mi <<= W+1;
     // +1 bit to compute rnd bit
-    quotient = (op1_mi / op2);
-    exact = !(op1_mi % op2);
+    ac_int<2*W+1,false> q = op1_mi / op2;
+    quotient = q;
+    // remainder from the quotient instead of a second long division
+    exact = q * op2 == op1_mi;
   }
 
 #ifdef __SYNTHESIS__
@@ -254,6 +265,52 @@ namespace ac {
     sqrt = r;
     return rem;
   }
+
+  // Same result as fx_sqrt: the root of the 2*WR MSBs of x (x is zero
+  // extended or truncated), computed as an integer square root with a double
+  // precision seed, Newton-Raphson refinement and exact correction
+  template<int W, int WR>
+  bool fx_sqrt_sim( ac_int<W,false> x, ac_int<WR,false> &sqrt) {
+    const bool W_odd = W&1;
+    const int ZW = W + W_odd;
+    const int NW = 2*WR;
+    ac_int<ZW,false> z = x;
+    z <<= W_odd;
+    ac_int<NW,false> n = 0;
+    if(NW >= ZW) {
+      n = z;
+      n <<= NW - ZW;
+    } else
+      n = z >> (ZW - NW);
+    if(NW <= 64) {
+      Ulong v = n.to_uint64();
+      Ulong r = (Ulong) std::sqrt((double) v);
+      // the seed is within a few units, correct without overflowing r*r
+      while(r && r > v / r)
+        r--;
+      while(r + 1 <= v / (r + 1))
+        r++;
+      sqrt = r;
+      return v != r * r;
+    }
+    bool all_zero;
+    const int ls = n.leading_sign(all_zero).to_int();
+    if(all_zero) {
+      sqrt = 0;
+      return false;
+    }
+    // n = m*2^(2*s) with m holding the 52 or 53 MSBs of n
+    const int s = AC_MAX((NW - ls - 52) >> 1, 0);
+    const double m = (n >> 2*s).to_double();
+    ac_int<WR+1,false> r = (Ulong) std::sqrt(m) + 2;
+    r <<= s;
+    // r >= sqrt(n): the Newton iteration decreases monotonically and stops
+    // at floor(sqrt(n)), the first iterate with r*r <= n
+    while(n < r * r)
+      r = (n / r + r) >> 1;
+    sqrt = r;
+    return n != r * r;
+  }
 }
 
 #ifndef AC_STD_FLOAT_FX_DIV_OVERRIDE
@@ -264,6 +321,14 @@ namespace ac {
 #endif
 #endif
 
+#ifndef AC_STD_FLOAT_FX_SQRT_OVERRIDE
+#ifdef __SYNTHESIS__
+#define AC_STD_FLOAT_FX_SQRT_OVERRIDE ac::fx_sqrt
+#else
+#define AC_STD_FLOAT_FX_SQRT_OVERRIDE ac::fx_sqrt_sim
+#endif
+#endif
+
 template<int W, int E> class ac_std_float;
 
 #ifdef __AC_NAMESPACE
@@ -747,6 +812,67 @@ public:
   void assign_from(const ac_int<WI,SI> &x) {
     this->template assign_from<Q>(ac_fixed<WI,WI,SI>(x));
   }
+  // Direct conversion from any ac_float: bit-exact with
+  //   assign_from<Q>(f.to_ac_fixed())
+  // the normalized magnitude is shifted into a mu_bits+2 window (mantissa,
+  // round bit, sticky bit) instead of building the full range ac_fixed
+  template<ac_q_mode Q, int W2, int I2, int E2, ac_q_mode Q2>
+  void assign_from(const ac_float<W2,I2,E2,Q2> &f) {
+    ac_private::check_supported<Q>();
+    typedef ac_int<W2,false> x_u_t;
+    const int h_width = mu_bits+2;
+    const int t_width = AC_MAX(W2, h_width);
+    typedef ac_int<t_width,false> t_t;
+    ac_int<W2,true> x = f.m.template slc<W2>(0);
+    bool sign = x < 0;
+    x_u_t x_u = sign ? (x_u_t) -x : (x_u_t) x;
+    bool all_zero;
+    int ls = x_u.leading_sign(all_zero).to_int();
+    // weight of MSB of magnitude and of the LSB of x_u
+    int msb_exp = f.e.to_int() + I2 - 1 - ls;
+    int lsb_exp = f.e.to_int() + I2 - W2;
+    int r_exp = msb_exp < min_exp ? min_exp : msb_exp;
+    // window: bit 0 sticky, bit 1 round, bits 2.. mu_bits+1 mantissa with implied bit
+    int shift_r = (r_exp - mant_bits - 2) - lsb_exp;
+    t_t t = x_u;
+    bool sticky_bit = false;
+    if(shift_r > 0) {
+      if(shift_r > t_width)
+        shift_r = t_width;
+      t_t shifted_out_bits = t;
+      shifted_out_bits &= ~((~t_t(0)) << shift_r);
+      sticky_bit = !!shifted_out_bits;
+      t >>= shift_r;
+    } else {
+      t <<= -shift_r;
+    }
+    ac_int<h_width,false> h = t;
+    h[0] = h[0] | sticky_bit;
+    // extra MSB catches the carry of rounding up to the next binade
+    ac_fixed<mu_bits+1,mu_bits+3,false,Q> r_rnd = h;
+    bool rnd_ovf = r_rnd[mu_bits];
+    bool r_normal = r_rnd[mu_bits-1] | rnd_ovf;
+    ac_int<mant_bits,false> m_r = r_rnd.template slc<mant_bits>(0);
+    m_r &= ac_int<1,true>(!rnd_ovf);
+    int exp = r_exp + rnd_ovf;
+    bool r_inf = !all_zero & (exp > max_exp);
+    exp += exp_bias;
+    if(Q==AC_TRN_ZERO) {
+      exp = r_inf ? max_exp + exp_bias : exp;
+      m_r |= ac_int<1,true>(-r_inf);  // saturate (set all bits to 1) if r_inf
+      r_inf = false;
+    }
+    e_t e = r_inf ? -1 : r_normal ? exp : 0;
+    m_r &= ac_int<1,true>(!r_inf);
+    e &= ac_int<1,true>(r_normal);
+    d = m_r;
+    d.set_slc(mant_bits, e);
+    d[W-1] = sign;
+  }
+  template<int W2, int I2, int E2, ac_q_mode Q2>
+  explicit ac_std_float(const ac_float<W2,I2,E2,Q2> &f) {
+    assign_from<AC_RND_CONV>(f);
+  }
   template<int WFX, int IFX, bool SFX, ac_q_mode QFX, ac_o_mode OFX>
   explicit ac_std_float(const ac_fixed<WFX,IFX,SFX,QFX,OFX> &fx) {
     assign_from<AC_RND_CONV>(fx);
@@ -1456,7 +1582,7 @@ public:
     ac_int<mu_bits+1,false> op1_mi = op1_mu;
     op1_mi <<= exp_odd;
     ac_int<mu_bits+rnd,false> sq_rt;
-    bool sticky_bit = ac::fx_sqrt(op1_mi, sq_rt);
+    bool sticky_bit = AC_STD_FLOAT_FX_SQRT_OVERRIDE(op1_mi, sq_rt);
     bool r_normal = true;  // true for most practical cases on W,E
     if(mant_bits > -min_exp) {
       int exp_over = min_exp - exp;
@@ -2222,6 +2348,8 @@ public:
   explicit ac_ieee_float(const ac_int<WI,SI> &x) : Base(ac_std_float_t(x)) {}
   template<ac_q_mode Q>
   explicit ac_ieee_float(const ac_float<width-e_width+1,2,e_width,Q> &f) : Base(ac_std_float_t(f)) {}
+  template<int W2, int I2, int E2, ac_q_mode Q2>
+  explicit ac_ieee_float(const ac_float<W2,I2,E2,Q2> &f) : Base(ac_std_float_t(f)) {}
   template<ac_ieee_float_format Format2>
   ac_ieee_float<Format2> to_ac_ieee_float() const { return ac_ieee_float<Format2>(*this); }
   const ac_float_t to_ac_float() const {
@@ -2752,5 +2880,6 @@ inline bool isnan(const ac::bfloat16 &x) { return x.isnan(); }
 
 #undef __AC_DATA_PRIVATE
 #undef AC_STD_FLOAT_FX_DIV_OVERRIDE
+#undef AC_STD_FLOAT_FX_SQRT_OVERRIDE
 
 #endif
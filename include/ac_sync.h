@@ -33,6 +33,11 @@
 
 /*
 //  Source:         ac_sync.h
+//
+//  In C++ simulation an ac_sync counts its pending syncs instead of queueing
+//  'true' elements (see fifo_count in ac_channel.h): memory is constant and,
+//  once registered with ac::dataflow (or switched with use_ring_buffer), it
+//  may be used between threads, a blocked sync_in sleeping until sync_out.
 */
 
 #ifndef __AC_SYNC_H
@@ -56,7 +61,11 @@ public:
   typedef ac_channel<bool> Base;
 
   // constructor
-  ac_sync(): Base() { }
+  ac_sync(): Base() {
+#ifdef __AC_CHANNEL_COUNT
+    Base::chan.use_count(true);
+#endif
+  }
 
 template <typename ...T> 
 void sync_in(T &...t) {
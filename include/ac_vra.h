@@ -0,0 +1,900 @@
+/**************************************************************************
+ *                                                                        *
+ *  Algorithmic C (tm) Datatypes                                          *
+ *                                                                        *
+ *  Software Version: 2025.4                                              *
+ *                                                                        *
+ *  Release Date    : Thu Dec 11 10:19:28 PST 2025                        *
+ *  Release Type    : Production Release                                  *
+ *  Release Build   : 2025.4.1                                            *
+ *                                                                        *
+ *  Copyright 2025 Siemens                                                *
+ *                                                                        *
+ *                                                                        *
+ *                                                                        *
+ **************************************************************************
+ *  Licensed under the Apache License, Version 2.0 (the "License");       *
+ *  you may not use this file except in compliance with the License.      *
+ *  You may obtain a copy of the License at                               *
+ *                                                                        *
+ *      http://www.apache.org/licenses/LICENSE-2.0                        *
+ *                                                                        *
+ *  Unless required by applicable law or agreed to in writing, software   *
+ *  distributed under the License is distributed on an "AS IS" BASIS,     *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or       *
+ *  implied.                                                              *
+ *  See the License for the specific language governing permissions and   *
+ *  limitations under the License.                                        *
+ **************************************************************************
+ *                                                                        *
+ *  The most recent version of this package is available at github.       *
+ *                                                                        *
+ *************************************************************************/
+
+/*
+//  Source:         ac_vra.h
+//  Description:    built-in value range analysis backend for ac_int/ac_fixed
+//
+//  Compile with -DAC_INT_VRA and/or -DAC_FIXED_VRA. ac_int.h includes this
+//  header instead of vra_instr.h when -DAC_VRA_BUILTIN is given or when no
+//  vra_instr.h is found on the include path.
+//
+//  Every ac_int/ac_fixed variable is attributed to a site: the code address
+//  of its first update (or of its AC_VRA_NAME). All later updates of the
+//  variable go to that site. Operator results and the other temporaries of
+//  the library are not tracked, and a conversion temporary that is moved
+//  into a variable (x = expr of another type) counts as an update of the
+//  variable only. Per site the backend records:
+//    - number of value updates and of updates that overflowed the type
+//    - min and max value (64 integer and 64 fraction bits, saturated)
+//    - integer bits (and sign) needed to hold every value, and for ac_fixed
+//      the fraction bits needed to hold every value exactly
+//  Values are analyzed in their ac_int/ac_fixed representation (no
+//  conversion to double). Statistics go to per-thread tables that are
+//  merged when a thread exits, and one report is written at program exit
+//  to std::cerr, or to the file named by the AC_VRA_REPORT environment
+//  variable.
+//
+//  Sites are reported as module+offset (resolve with addr2line -f -C -i -e
+//  <module> <offset>) where dladdr is available, else as raw addresses.
+//  Without optimization the backend is forced inline into the ac_int/ac_fixed
+//  member called by the user code, so that sites are source locations at
+//  any optimization level. A variable can be given a name for the report (a
+//  no-op when VRA is off):
+//    ac_fixed<18,4> acc;
+//    AC_VRA_NAME(acc, "fir.acc");
+//
+//  Limitations:
+//    - A variable initialized with an operator result of its own type
+//      (auto x = a*b) is that result, so it is not tracked until its
+//      AC_VRA_NAME or its next update.
+//    - Tracking costs a record per update: a loop bound by ac_fixed
+//      multiply-accumulates (acc += x*h) runs about 18-20x slower at -O2
+//      than without VRA. Disable the tracking of hot variables that need no
+//      analysis with AC_INT_VRA_DISABLE/AC_FIXED_VRA_DISABLE.
+//
+//  AC_INT_VRA_DISABLE(x)/AC_INT_VRA_ENABLE(x) (and the AC_FIXED variants)
+//  stop and resume the tracking of one variable.
+*/
+
+#ifndef __AC_VRA_H
+#define __AC_VRA_H
+
+#if (__cplusplus < 201103L)
+#error Please use C++11 or a later standard for compilation.
+#endif
+
+// this header provides the vra_instr.h interface used by ac_int.h and ac_fixed.h
+#define _INCLUDED_VRA_INSTR_H_
+#define __AC_VRA_NATIVE
+
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+#if defined(__APPLE__) || (defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34)))
+#include <dlfcn.h>
+#define __AC_VRA_DLADDR
+#endif
+
+#if defined(__GNUC__)
+#define __AC_VRA_NOINLINE __attribute__((noinline))
+#define __AC_VRA_CALLER __builtin_return_address(0)
+// __AC_VRA_INLINE marks the functions between an ac_int/ac_fixed member called
+// by user code and site::get(), __AC_VRA_ENTRY the large such members. Without
+// optimization everything up to the member is forced inline, so the caller
+// address of get() is the return address of the member (in user code). With
+// optimization the members are forced inline too, and get() is called from
+// user code.
+#define __AC_VRA_INLINE __attribute__((always_inline))
+#ifdef __OPTIMIZE__
+#define __AC_VRA_ENTRY __attribute__((always_inline))
+#define __AC_VRA_SITE __AC_VRA_NOINLINE
+#else
+#define __AC_VRA_ENTRY
+#define __AC_VRA_SITE __attribute__((always_inline))
+#endif
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define __AC_VRA_NOINLINE __declspec(noinline)
+#define __AC_VRA_CALLER _ReturnAddress()
+#define __AC_VRA_INLINE
+#define __AC_VRA_ENTRY
+#define __AC_VRA_SITE __AC_VRA_NOINLINE
+#else
+#define __AC_VRA_NOINLINE
+#define __AC_VRA_CALLER ((void *)0)
+#define __AC_VRA_INLINE
+#define __AC_VRA_ENTRY
+#define __AC_VRA_SITE
+#endif
+
+#ifdef AC_INT_VRA
+#define __AC_INT_NUMERICAL_ANALYSIS_BASE ac_vra_ns::int_base<W,S>
+#endif
+#ifdef AC_FIXED_VRA
+#define __AC_FIXED_NUMERICAL_ANALYSIS_BASE ac_vra_ns::fixed_base<W,I,S,Q,O>
+#endif
+
+#ifdef __AC_NAMESPACE
+namespace __AC_NAMESPACE {
+#endif
+
+enum ac_q_mode { AC_TRN, AC_RND, AC_TRN_ZERO, AC_RND_ZERO, AC_RND_INF, AC_RND_MIN_INF, AC_RND_CONV, AC_RND_CONV_ODD };
+enum ac_o_mode { AC_WRAP, AC_SAT, AC_SAT_ZERO, AC_SAT_SYM };
+
+// AC_VRA_STACK_NOT_TRACED: a temporary of the library, not tracked
+enum ac_vra_stack_trace_modes { AC_VRA_STACK_TRACED, AC_VRA_STACK_NOT_TRACED };
+
+template<int W, bool S> class ac_int;
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> class ac_fixed;
+
+namespace ac_vra_ns {
+
+  // Integer bits needed for a value: for x >= 0 the bits of x, for x < 0
+  // 1 + the bits of ~x, relative to the binary point (so 0.25 needs -1).
+  // A signed type holds x when this is <= I (x < 0) or < I (x >= 0)
+  template <int W2, bool S2>
+  int calc_int_bits(const ac_int<W2, S2> &op2);
+  template <class T>
+  int calc_int_bits(const T op2);
+  template <int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+  int calc_int_bits(const ac_fixed<W2, I2, S2, Q2, O2> &op2);
+  inline int calc_int_bits(double d, bool = false);
+
+  // fraction bits needed to hold the value exactly (returned as double)
+  template <int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+  double calc_frac_value(const ac_fixed<W2, I2, S2, Q2, O2> &op2);
+  inline double calc_frac_value(double d);
+
+  // a value as a signed 64.64 fixed point number
+  struct value {
+    long long hi;
+    unsigned long long lo;
+    bool operator<(const value &b) const { return hi < b.hi || (hi == b.hi && lo < b.lo); }
+    long double to_ld() const { return (long double) hi + std::ldexp((long double) lo, -64); }
+  };
+
+  inline int msb(unsigned long long x) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(x);
+#else
+    int r = 0;
+    while (x >>= 1)
+      r++;
+    return r;
+#endif
+  }
+
+  inline int lsb(unsigned long long x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int r = 0;
+    while (!(x & 1)) {
+      x >>= 1;
+      r++;
+    }
+    return r;
+#endif
+  }
+
+  // integer bits (see calc_int_bits) of a value
+  inline int int_bits(const value &x) {
+    const bool neg = x.hi < 0;
+    const unsigned long long h = neg ? ~(unsigned long long) x.hi : (unsigned long long) x.hi;
+    const unsigned long long l = neg ? ~x.lo : x.lo;
+    return (h ? msb(h) + 64 : l ? msb(l) : -1) + 1 + neg - 64;
+  }
+
+  // two's complement words of an ac_int/ac_fixed (v[0] least significant)
+  struct words {
+    const int *v;
+    int n;
+    unsigned fill() const { return v[n-1] < 0 ? ~0u : 0u; }
+    unsigned word(int i) const { return i < 0 ? 0u : i >= n ? fill() : (unsigned) v[i]; }
+    // 32 bits from bit position pos (may be negative or beyond the top)
+    unsigned get32(int pos) const {
+      const int w = pos >= 0 ? pos / 32 : -((31 - pos) / 32);
+      const int b = pos - 32*w;
+      unsigned r = word(w) >> b;
+      if (b)
+        r |= word(w+1) << (32 - b);
+      return r;
+    }
+    unsigned long long get64(int pos) const {
+      return get32(pos) | (unsigned long long) get32(pos + 32) << 32;
+    }
+    // sign extended value of an ac_int/ac_fixed of at most 64 bits
+    long long get() const { return n == 1 ? (long long) v[0] : (long long) ((unsigned long long) (unsigned) v[0] | (unsigned long long) v[1] << 32); }
+    // integer bits (see calc_int_bits) with f fraction bits
+    int int_bits(int f) const {
+      if (n <= 2) {
+        const long long x = get();
+        const unsigned long long u = x < 0 ? ~(unsigned long long) x : (unsigned long long) x;
+        return (u ? msb(u) + 1 : 0) + (x < 0) - f;
+      }
+      const unsigned s = fill();
+      int i = n - 1;
+      while (i >= 0 && (unsigned) v[i] == s)
+        i--;
+      const int p = i < 0 ? -1 : 32*i + msb((unsigned) v[i] ^ s);
+      return p + 1 + (s != 0) - f;
+    }
+    int frac_bits(int f) const {
+      if (n <= 2) {
+        const long long x = get();
+        return x && f > 0 ? std::max(0, f - lsb((unsigned long long) x)) : 0;
+      }
+      for (int i = 0; i < n && 32*i < f; i++)
+        if (v[i])
+          return std::max(0, f - (32*i + lsb((unsigned) v[i])));
+      return 0;
+    }
+    // false: saturated or fraction bits below 2^-64 dropped
+    bool to_value(int f, value &r) const {
+      if (n <= 2 && f >= 0 && f <= 64) {
+        const long long x = get();
+        r.hi = f == 64 ? (x < 0 ? -1 : 0) : x >> f;
+        r.lo = f ? (unsigned long long) x << (64 - f) : 0;
+        return true;
+      }
+      const bool neg = v[n-1] < 0;
+      const unsigned s = (get32(f + 32) >> 31) ? ~0u : 0u;
+      bool fits = (s != 0) == neg;
+      for (int p = f + 64; fits && p < 32*n; p += 32)
+        fits = get32(p) == s;
+      if (!fits) {
+        r.hi = neg ? LLONG_MIN : LLONG_MAX;
+        r.lo = neg ? 0 : ~0ull;
+        return false;
+      }
+      r.hi = (long long) get64(f);
+      r.lo = get64(f - 64);
+      return f <= 64 || frac_bits(f) <= 64;
+    }
+  };
+
+  // access to the representation of ac_int and ac_fixed
+  struct access {
+    template <int W2, bool S2>
+    static words of(const ac_int<W2, S2> &x) { words r = { x.v, (W2+31+!S2)/32 }; return r; }
+    template <int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    static words of(const ac_fixed<W2, I2, S2, Q2, O2> &x) { words r = { x.v, (W2+31+!S2)/32 }; return r; }
+  };
+
+  template <int W2, bool S2>
+  int calc_int_bits(const ac_int<W2, S2> &op2) { return access::of(op2).int_bits(0); }
+
+  template <int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+  int calc_int_bits(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { return access::of(op2).int_bits(W2-I2); }
+
+  template <class T>
+  int calc_int_bits(const T op2) {
+    if (std::is_floating_point<T>::value)
+      return calc_int_bits((double) op2);
+    const bool neg = op2 < (T) 0;
+    const unsigned long long u = neg ? ~(unsigned long long)(long long) op2 : (unsigned long long) op2;
+    return (u ? msb(u) + 1 : 0) + neg;
+  }
+
+  inline int calc_int_bits(double d, bool) {
+    if (d == 0 || d != d)
+      return 0;
+    int e;
+    const double m = std::frexp(d, &e);
+    return d < 0 && m != -0.5 ? e + 1 : e;
+  }
+
+  template <int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+  double calc_frac_value(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { return access::of(op2).frac_bits(W2-I2); }
+
+  inline double calc_frac_value(double d) {
+    double f = d - std::floor(d);
+    int n = 0;
+    for (; f != 0 && n < 1100; n++) {
+      f *= 2;
+      f -= std::floor(f);
+    }
+    return n;
+  }
+
+  // conversions to value; false: not exact (see words::to_value)
+  template <int W2, bool S2>
+  bool to_value(const ac_int<W2, S2> &x, value &r) { return access::of(x).to_value(0, r); }
+
+  template <int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+  bool to_value(const ac_fixed<W2, I2, S2, Q2, O2> &x, value &r) { return access::of(x).to_value(W2-I2, r); }
+
+  inline bool to_value(double d, value &r) {
+    const double i = std::floor(d);
+    if (!(i >= -0x1p63 && i < 0x1p63)) {
+      r.hi = d < 0 ? LLONG_MIN : LLONG_MAX;
+      r.lo = d < 0 ? 0 : ~0ull;
+      return false;
+    }
+    const double l = std::ldexp(d - i, 64);
+    r.hi = (long long) i;
+    r.lo = (unsigned long long) l;
+    return l == std::floor(l);
+  }
+
+  template <class T>
+  bool to_value_native(T t, value &r, std::true_type) { return to_value((double) t, r); }
+
+  template <class T>
+  bool to_value_native(T t, value &r, std::false_type) {
+    r.lo = 0;
+    if (!(t < (T) 0) && (unsigned long long) t > (unsigned long long) LLONG_MAX) {
+      r.hi = LLONG_MAX;
+      r.lo = ~0ull;
+      return false;
+    }
+    r.hi = (long long) t;
+    return true;
+  }
+
+  template <class T>
+  bool to_value(T t, value &r) { return to_value_native(t, r, typename std::is_floating_point<T>::type()); }
+
+  enum { none = INT_MIN / 2 };
+
+  class table;
+
+  struct key {
+    const void *addr;
+    int w, i;
+    bool s, fixed;
+    bool operator==(const key &k) const { return addr == k.addr && w == k.w && i == k.i && s == k.s && fixed == k.fixed; }
+    bool operator<(const key &k) const {
+      if (addr != k.addr) return std::less<const void *>()(addr, k.addr);
+      if (w != k.w) return w < k.w;
+      if (i != k.i) return i < k.i;
+      if (s != k.s) return s < k.s;
+      return fixed < k.fixed;
+    }
+  };
+
+  struct key_hash {
+    size_t operator()(const key &k) const { return std::hash<const void *>()(k.addr) ^ (size_t) (k.w * 31 + k.i); }
+  };
+
+  // statistics of one site in one thread
+  struct record {
+    key k;
+    const table *owner;
+    std::string name;
+    unsigned long long updates;
+    unsigned long long overflows;
+    value min, max;
+    unsigned long long frac_or;   // fraction words of the exact values or-ed
+    // integer and fraction bits of the values that are not exact (saturated
+    // or more than 64 fraction bits); the bits of the exact values follow
+    // from min, max and frac_or
+    bool saturated;
+    int pos_bits;   // integer bits needed by the values >= 0 (none: no such value)
+    int neg_bits;   // integer bits needed by the values < 0
+    int frac_bits;
+
+    record(const key &k_, const table *o)
+      : k(k_), owner(o), updates(0), overflows(0), frac_or(0), saturated(false), pos_bits(none), neg_bits(none), frac_bits(0) {
+      min.hi = LLONG_MAX;
+      min.lo = ~0ull;
+      max.hi = LLONG_MIN;
+      max.lo = 0;
+    }
+
+    void add(const value &x, bool exact, int ibits, int fbits, bool ovf) {
+      if (x < min) min = x;
+      if (max < x) max = x;
+      updates++;
+      overflows += ovf;
+      if (exact)
+        frac_or |= x.lo;
+      else
+        add_inexact(x, ibits, fbits);
+    }
+
+    void merge(const record &r) {
+      if (!r.updates)
+        return;
+      if (r.min < min) min = r.min;
+      if (max < r.max) max = r.max;
+      updates += r.updates;
+      overflows += r.overflows;
+      frac_or |= r.frac_or;
+      saturated |= r.saturated;
+      pos_bits = std::max(pos_bits, r.pos_bits);
+      neg_bits = std::max(neg_bits, r.neg_bits);
+      frac_bits = std::max(frac_bits, r.frac_bits);
+      if (name.empty())
+        name = r.name;
+    }
+
+    // integer bits needed by the values >= 0 and < 0, and fraction bits
+    int needed_pos_bits() const { return std::max(pos_bits, max.hi > 0 || (!max.hi && max.lo) ? int_bits(max) : (int) none); }
+    int needed_neg_bits() const { return std::max(neg_bits, min.hi < 0 ? int_bits(min) : (int) none); }
+    int needed_frac_bits() const { return std::max(frac_bits, frac_or ? 64 - lsb(frac_or) : 0); }
+
+  private:
+    __AC_VRA_NOINLINE void add_inexact(const value &x, int ibits, int fbits) {
+      saturated |= (x.hi == LLONG_MIN && !x.lo) || (x.hi == LLONG_MAX && !~x.lo);
+      if (x.hi || x.lo) {
+        int &b = x.hi < 0 ? neg_bits : pos_bits;
+        if (ibits > b) b = ibits;
+      }
+      if (fbits > frac_bits) frac_bits = fbits;
+    }
+  };
+
+  // merged statistics, written at exit
+  class report {
+  public:
+    static report &global() {
+      static report r;
+      return r;
+    }
+
+    // records live until exit, so that variables never hold a dangling record
+    record *alloc(const key &k, const table *owner) {
+      std::lock_guard<std::mutex> lk(m);
+      arena.push_back(record(k, owner));
+      return &arena.back();
+    }
+
+    // fold the records of an exiting thread into the sites
+    void merge(const std::vector<record *> &recs) {
+      std::lock_guard<std::mutex> lk(m);
+      for (size_t j = 0; j < recs.size(); j++) {
+        record &r = *recs[j];
+        std::map<key, record>::iterator it = sites.find(r.k);
+        if (it == sites.end())
+          it = sites.insert(std::make_pair(r.k, record(r.k, 0))).first;
+        it->second.merge(r);
+        if (!r.name.empty())
+          it->second.name = r.name;
+        r.owner = 0;
+      }
+    }
+
+    void write(std::ostream &os) {
+      std::lock_guard<std::mutex> lk(m);
+      size_t n = 0;
+      for (std::map<key, record>::iterator it = sites.begin(); it != sites.end(); ++it)
+        n += it->second.updates != 0;
+      os << "AC VRA report: " << n << " sites\n";
+      os << "site, type, updates, overflows, min, max, needed type\n";
+      std::ios_base::fmtflags f = os.flags();
+      std::streamsize p = os.precision(17);
+      for (std::map<key, record>::iterator it = sites.begin(); it != sites.end(); ++it) {
+        const record &r = it->second;
+        if (!r.updates)
+          continue;
+        os << site_name(r) << ", " << type_name(r.k.fixed, r.k.w, r.k.i, r.k.s) << ", "
+           << r.updates << ", " << r.overflows << ", "
+           << (r.saturated && r.min.hi == LLONG_MIN ? "<=" : "") << r.min.to_ld() << ", "
+           << (r.saturated && r.max.hi == LLONG_MAX ? ">=" : "") << r.max.to_ld() << ", ";
+        // integer bits needed: signed when negative values were seen
+        const int pb = r.needed_pos_bits(), nb = r.needed_neg_bits();
+        const bool neg = nb != none;
+        int ib = neg ? std::max(nb, pb + 1) : pb;
+        const int fb = r.k.fixed ? r.needed_frac_bits() : 0;
+        if (ib == none) ib = 0;
+        if (!r.k.fixed && ib < 1) ib = 1;
+        os << type_name(r.k.fixed, std::max(ib + fb, 1), ib, neg) << "\n";
+      }
+      os.flags(f);
+      os.precision(p);
+    }
+
+    ~report() {
+      const char *fn = std::getenv("AC_VRA_REPORT");
+      if (fn && *fn) {
+        std::ofstream ofs(fn);
+        write(ofs);
+      } else {
+        write(std::cerr);
+      }
+    }
+
+  private:
+    static std::string type_name(bool fixed, int w, int i, bool s) {
+      std::string r = fixed ? "ac_fixed<" : "ac_int<";
+      r += std::to_string(w);
+      if (fixed)
+        r += "," + std::to_string(i);
+      r += s ? ",true>" : ",false>";
+      return r;
+    }
+
+    static std::string site_name(const record &r) {
+      std::string n;
+      if (!r.name.empty())
+        n = r.name + " ";
+      char buf[64];
+      // the call instruction rather than the return address, so that it
+      // resolves to the line of the call
+      const char *a = (const char *) r.k.addr - (r.k.addr != 0);
+#ifdef __AC_VRA_DLADDR
+      Dl_info info;
+      if (r.k.addr && dladdr(r.k.addr, &info) && info.dli_fname) {
+        snprintf(buf, sizeof(buf), "+0x%llx", (unsigned long long) (a - (const char *) info.dli_fbase));
+        return n + info.dli_fname + buf;
+      }
+#endif
+      snprintf(buf, sizeof(buf), "%p", (const void *) a);
+      return n + buf;
+    }
+
+    std::mutex m;
+    std::deque<record> arena;
+    std::map<key, record> sites;
+  };
+
+  // per-thread site records
+  class table {
+  public:
+    // the table of this thread (null after the thread's table is gone)
+    static table *local() {
+      table *t = current();
+      return t ? t : create();
+    }
+
+    static table *&current() {
+      static thread_local table *t = 0;
+      return t;
+    }
+
+    record *find(const key &k) {
+      const size_t h = key_hash()(k);
+      record *&c = cache[(h ^ (h >> 8)) & (cache_size - 1)];
+      if (c && c->k == k)
+        return c;
+      std::unordered_map<key, record *, key_hash>::iterator it = index.find(k);
+      if (it == index.end()) {
+        recs.push_back(report::global().alloc(k, this));
+        it = index.insert(std::make_pair(k, recs.back())).first;
+      }
+      return c = it->second;
+    }
+
+    // The first update of a variable is held back until the next one: when
+    // the variable is a conversion temporary that is moved into another
+    // variable, the move drops it.
+    void hold(const void *obj, record *r, const value &x, bool exact, int ibits, int fbits, bool ovf) {
+      flush();
+      held.obj = obj;
+      held.rec = r;
+      held.x = x;
+      held.exact = exact;
+      held.ibits = ibits;
+      held.fbits = fbits;
+      held.ovf = ovf;
+    }
+
+    void flush() {
+      if (held.rec)
+        held.rec->add(held.x, held.exact, held.ibits, held.fbits, held.ovf);
+      held.rec = 0;
+    }
+
+    // obj was moved into to: its held update, if any, becomes one of to
+    // with record r (null: dropped)
+    bool pass(const void *obj, const void *to, record *r) {
+      if (held.obj != obj || !held.rec)
+        return false;
+      held.obj = to;
+      held.rec = r;
+      return true;
+    }
+
+    ~table() {
+      flush();
+      report::global().merge(recs);
+      current() = 0;
+      dead() = true;
+    }
+
+  private:
+    enum { cache_size = 256 };
+
+    table() {
+      report::global();
+      std::fill(cache, cache + cache_size, (record *) 0);
+      held.obj = 0;
+      held.rec = 0;
+      current() = this;
+    }
+
+    static bool &dead() {
+      static thread_local bool d = false;
+      return d;
+    }
+
+    static table *create() {
+      if (dead())
+        return 0;
+      static thread_local table t;
+      return &t;
+    }
+
+    record *cache[cache_size];
+    std::unordered_map<key, record *, key_hash> index;
+    std::vector<record *> recs;
+    struct {
+      const void *obj;
+      record *rec;   // null: none
+      value x;
+      bool exact, ovf;
+      int ibits, fbits;
+    } held;
+  };
+
+  // this thread's record of a site
+  inline record *lookup(const void *addr, int w, int i, bool s, bool fixed) {
+    table *t = table::local();
+    if (!t)
+      return 0;
+    key k = { addr, w, i, s, fixed };
+    return t->find(k);
+  }
+
+  // record of the site that called the caller of get(); the sites of one
+  // type are cached per thread by code address, so the common case is one
+  // compare instead of a table probe
+  template <int W, int I, bool S, bool F>
+  struct site {
+    struct slot {
+      const void *addr;
+      const table *owner;
+      record *rec;
+    };
+    enum { cache_size = 16 };
+
+    static __AC_VRA_SITE record *get() {
+      const void *a = __AC_VRA_CALLER;
+      slot &e = cache()[((size_t) a >> 2) & (cache_size - 1)];
+      const table *t = table::current();
+      if (e.addr == a && e.owner == t && t)
+        return e.rec;
+      e.rec = lookup(a, W, I, S, F);
+      e.addr = a;
+      e.owner = e.rec ? table::current() : 0;
+      return e.rec;
+    }
+
+  private:
+    static slot *cache() {
+      static thread_local slot c[cache_size];
+      return c;
+    }
+  };
+
+  // state shared by the ac_int and ac_fixed bases
+  class base {
+  public:
+    void disable_vra() { off = true; }
+    void enable_vra() { off = false; }
+
+  protected:
+    record *rec;   // null: site not bound yet
+    bool off;
+    bool temp;     // a temporary of the library, not tracked
+    bool fresh;    // no update yet
+
+    explicit base(bool t = false) : rec(0), off(false), temp(t), fresh(true) {}
+
+    // this thread's record of the bound site
+    record *local_rec() {
+      const table *t = table::current();
+      return t && rec->owner == t ? rec : rebind();
+    }
+
+    void record_update(record *r, const value &x, bool exact, int ibits, int fbits, bool ovf) {
+      if (fresh)
+        hold(r, x, exact, ibits, fbits, ovf);
+      else
+        r->add(x, exact, ibits, fbits, ovf);
+    }
+
+    // this object was moved into to (see table::pass)
+    bool pass_to(const base *to, record *r) const {
+      table *t = table::current();
+      return t && !fresh && t->pass(this, to, r);
+    }
+
+    static void name(record *r, const char *n) {
+      if (r)
+        r->name = n;
+    }
+
+  private:
+    // the record of the bound site in another thread than the last one
+    __AC_VRA_NOINLINE record *rebind() {
+      table *t = table::local();
+      return t ? rec = t->find(rec->k) : 0;
+    }
+
+    __AC_VRA_NOINLINE void hold(record *r, const value &x, bool exact, int ibits, int fbits, bool ovf) {
+      fresh = false;
+      table::current()->hold(this, r, x, exact, ibits, fbits, ovf);
+    }
+  };
+
+  template <int W, bool S>
+  class int_base : public base {
+  public:
+    int_base() {}
+    int_base(ac_vra_stack_trace_modes m) : base(m == AC_VRA_STACK_NOT_TRACED) {}
+    // a copy of a tracked variable is a new variable at the copy
+    __AC_VRA_INLINE int_base(const int_base &o) : base(o.temp) {
+      off = o.off;
+      if (o.rec)
+        record_self();
+    }
+    // a moved object goes on as the new one
+    int_base(int_base &&o) : base(o) { o.pass_to(this, rec); }
+    __AC_VRA_INLINE int_base &operator=(const int_base &) {
+      record_self();
+      return *this;
+    }
+    // x = <temporary>: the update that made the temporary (with the value
+    // and overflow before the conversion) is the update of x
+    __AC_VRA_INLINE int_base &operator=(int_base &&o) {
+      record *r = off || temp ? 0 : bind();
+      if (o.pass_to(this, r))
+        fresh = false;
+      else if (r)
+        record_self(r);
+      return *this;
+    }
+
+    // name the site of this variable in the report (and track it)
+    __AC_VRA_INLINE void vra_name(const char *n) {
+      temp = false;
+      name(bind(), n);
+    }
+
+    template <class V>
+    __AC_VRA_INLINE void update(const V &orig, bool ovf, int int_bits) {
+      if (off || temp)
+        return;
+      if (record *r = bind())
+        record_value(r, orig, ovf, int_bits);
+    }
+
+  private:
+    // only the binding is inlined into the caller, the rest is kept out of it
+    __AC_VRA_INLINE record *bind() { return rec ? local_rec() : (rec = site<W, W, S, false>::get()); }
+
+    template <class V>
+    __AC_VRA_NOINLINE void record_value(record *r, const V &orig, bool ovf, int int_bits) {
+      value x;
+      const bool exact = to_value(orig, x);
+      record_update(r, x, exact, int_bits, 0, ovf);
+    }
+
+    __AC_VRA_INLINE void record_self() {
+      if (off || temp)
+        return;
+      if (record *r = bind())
+        record_self(r);
+    }
+
+    __AC_VRA_NOINLINE void record_self(record *r) {
+      const ac_int<W,S> &self = static_cast<const ac_int<W,S> &>(*this);
+      record_value(r, self, false, calc_int_bits(self));
+    }
+  };
+
+  template <int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  class fixed_base : public base {
+  public:
+    fixed_base() {}
+    fixed_base(ac_vra_stack_trace_modes m) : base(m == AC_VRA_STACK_NOT_TRACED) {}
+    __AC_VRA_INLINE fixed_base(const fixed_base &o) : base(o.temp) {
+      off = o.off;
+      if (o.rec)
+        record_self();
+    }
+    fixed_base(fixed_base &&o) : base(o) { o.pass_to(this, rec); }
+    __AC_VRA_INLINE fixed_base &operator=(const fixed_base &) {
+      record_self();
+      return *this;
+    }
+    __AC_VRA_INLINE fixed_base &operator=(fixed_base &&o) {
+      record *r = off || temp ? 0 : bind();
+      if (o.pass_to(this, r))
+        fresh = false;
+      else if (r)
+        record_self(r);
+      return *this;
+    }
+
+    __AC_VRA_INLINE void vra_name(const char *n) {
+      temp = false;
+      name(bind(), n);
+    }
+
+    template <class V>
+    __AC_VRA_INLINE void update(bool overflow, bool, const V &op, int int_bits, double frac_value) {
+      if (off || temp)
+        return;
+      if (record *r = bind())
+        record_value(r, op, overflow, int_bits, (int) frac_value);
+    }
+
+  private:
+    __AC_VRA_INLINE record *bind() { return rec ? local_rec() : (rec = site<W, I, S, true>::get()); }
+
+    template <class V>
+    __AC_VRA_NOINLINE void record_value(record *r, const V &op, bool overflow, int int_bits, int frac_bits) {
+      value x;
+      const bool exact = to_value(op, x);
+      record_update(r, x, exact, int_bits, frac_bits, overflow);
+    }
+
+    __AC_VRA_INLINE void record_self() {
+      if (off || temp)
+        return;
+      if (record *r = bind())
+        record_self(r);
+    }
+
+    __AC_VRA_NOINLINE void record_self(record *r) {
+      const ac_fixed<W,I,S,Q,O> &self = static_cast<const ac_fixed<W,I,S,Q,O> &>(*this);
+      record_value(r, self, false, calc_int_bits(self), (int) calc_frac_value(self));
+    }
+  };
+
+  template <class V>
+  inline __AC_VRA_INLINE auto set_name(V &x, const char *n, int) -> decltype(x.vra_name(n), void()) { x.vra_name(n); }
+
+  // the type is not tracked (AC_INT_VRA or AC_FIXED_VRA only)
+  template <class V>
+  void set_name(V &, const char *, long) {}
+
+} // namespace ac_vra_ns
+
+// name the site of an ac_int/ac_fixed variable in the VRA report
+template <class V>
+inline void ac_vra_name(V &x, const char *n) { ac_vra_ns::set_name(x, n, 0); }
+
+#ifdef __AC_NAMESPACE
+} // namespace __AC_NAMESPACE
+#endif
+
+#endif // __AC_VRA_H
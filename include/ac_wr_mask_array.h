@@ -59,6 +59,125 @@
 #include <ac_assert.h>
 #include <ac_bank_array.h>
 
+// In C simulation (neither __SYNTHESIS__ nor CCS_SCVERIFY defined) the
+// separate-RAM-per-slice array keeps each word as one packed ac_int and
+// applies the write mask with whole-word operations: (old & ~m) | (new & m).
+// Define AC_WR_MASK_ARRAY_XCHECK to simulate the per-slice sc_lv storage
+// instead, whose reads assert on X (never written) data.
+#if !defined(__SYNTHESIS__) && !defined(CCS_SCVERIFY) && !defined(AC_WR_MASK_ARRAY_XCHECK)
+#define __AC_WR_MASK_ARRAY_NATIVE
+#endif
+
+#ifdef __AC_WR_MASK_ARRAY_NATIVE
+
+template <typename T, int Dim1, int SliceWidth=1, bool use_be_ram=0>
+class ac_wr_mask_array_1D
+{
+public:
+
+  static const unsigned dim1 = Dim1;
+  typedef Wrapped<T> WData_t;
+  static const unsigned int WordWidth = WData_t::width;
+  static const unsigned num_slices = WordWidth/SliceWidth;
+  typedef ac_int<num_slices, false> WriteMask;
+  static const unsigned idx_width = ac::log2_ceil<Dim1>::val;
+  typedef ac_int<idx_width, false> idx_t;
+  typedef sc_lv<WordWidth> Data_t;
+  typedef sc_lv<SliceWidth> Slice_t;
+  typedef ac_int<WordWidth, false> Word_t;
+  typedef ac_int<SliceWidth, false> SliceBits_t;
+  Word_t mem[Dim1];
+
+  static_assert(WordWidth == num_slices *SliceWidth,
+                "Word width must be evenly divisible by SliceWidth");
+
+  void write(unsigned idx, T val, WriteMask mask_val=~0) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < ac_wr_mask_array_1D::dim1);
+    write_word(idx, to_bits<WordWidth>(val), mask_val);
+  }
+
+  template <typename slice_t>
+  void write(idx_t idx, const slice_t val[num_slices], WriteMask mask_val=~0) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < ac_wr_mask_array_1D::dim1);
+    for (unsigned i = 0; i < num_slices; i++) {
+      if (mask_val[i] == 1)
+      { mem[idx].set_slc(i*SliceWidth, to_bits<SliceWidth>(val[i])); }
+    }
+  }
+
+  T read(unsigned idx) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < ac_wr_mask_array_1D::dim1);
+    return from_bits<T>(mem[idx]);
+  }
+
+  template <typename slice_t>
+  void read(slice_t val[num_slices], unsigned idx) {
+    AC_A_BANK_ARRAY_ASSERTION(idx < ac_wr_mask_array_1D::dim1);
+    for (unsigned i = 0; i < num_slices; i++) {
+      val[i] = from_bits<slice_t>(mem[idx].template slc<SliceWidth>(i*SliceWidth));
+    }
+  }
+
+  struct elem_proxy {
+    ac_wr_mask_array_1D &array;
+    unsigned idx;
+    ac_wr_mask_array_1D::WriteMask mask_val{~0};
+
+    elem_proxy(ac_wr_mask_array_1D &_array, unsigned _idx, ac_wr_mask_array_1D::WriteMask _mask=~0)
+      : array(_array), idx(_idx), mask_val(_mask) {}
+
+    operator T () { return array.read(idx); }
+
+    void operator=(const T &val) { array.write(idx, val, mask_val); }
+
+    elem_proxy mask(ac_wr_mask_array_1D::WriteMask _mask) {
+      return elem_proxy(array, idx, _mask);
+    }
+  };
+
+  elem_proxy operator[](unsigned idx) { return elem_proxy(*this, idx); }
+  const elem_proxy operator[](unsigned idx) const { return elem_proxy(*this, idx); }
+
+private:
+  void write_word(unsigned idx, const Word_t &w, const WriteMask &mask_val) {
+    if (mask_val.and_reduce()) {
+      mem[idx] = w;
+      return;
+    }
+    Word_t m = 0;
+    for (unsigned i = 0; i < num_slices; i++) {
+      if (mask_val[i] == 1)
+      { m.set_slc(i*SliceWidth, SliceBits_t(-1)); }
+    }
+    mem[idx] = (mem[idx] & m.bit_complement()) | (w & m);
+  }
+
+  // packed bits of a value: ac_int/ac_fixed directly, other types through
+  // the Connections marshaller
+  template <int N, int W, bool S>
+  static ac_int<N, false> to_bits(const ac_int<W,S> &v) { return v; }
+  template <int N, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  static ac_int<N, false> to_bits(const ac_fixed<W,I,S,Q,O> &v) { return v.template slc<W>(0); }
+  template <int N, typename U>
+  static ac_int<N, false> to_bits(const U &v) { return TypeToNVUINT(v); }
+
+  template <typename U> struct tag {};
+  template <int N, int W, bool S>
+  static ac_int<W,S> from_bits(const ac_int<N, false> &b, tag< ac_int<W,S> >) { return b; }
+  template <int N, int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+  static ac_fixed<W,I,S,Q,O> from_bits(const ac_int<N, false> &b, tag< ac_fixed<W,I,S,Q,O> >) {
+    ac_fixed<W,I,S,Q,O> r;
+    r.set_slc(0, b);
+    return r;
+  }
+  template <int N, typename U>
+  static U from_bits(const ac_int<N, false> &b, tag<U>) { return NVUINTToType<U>(b); }
+  template <typename U, int N>
+  static U from_bits(const ac_int<N, false> &b) { return from_bits(b, tag<U>()); }
+};
+
+#else // __AC_WR_MASK_ARRAY_NATIVE
+
 template <typename T, int Dim1, int SliceWidth=1, bool use_be_ram=0>
 class ac_wr_mask_array_1D
 {
@@ -164,6 +283,8 @@ public:
   const elem_proxy operator[](unsigned idx) const { return elem_proxy(*this, idx); }
 };
 
+#endif // __AC_WR_MASK_ARRAY_NATIVE
+
 
 // Specialization for mapping to a true byte_enable RAM
 // When using,
@@ -85,3 +85,89 @@ void ac_xbar(ac_int<NUM_IN, false> sel_i[NUM_OUT], ac_channel<T> &chan, Args&...
     }
   }
 }
+
+// ac_xbar_cached<NUM_IN, NUM_OUT, T> is a crossbar with the same behavior as
+// ac_xbar that keeps its routing table between calls:
+//   ac_xbar_cached<32, 32, T> xbar;
+//   xbar(sel_i, in0, ..., in31, out0, ..., out31);
+// In C simulation sel_i is decoded (and checked for one-hotness) only when it
+// differs from the previous call. Each call then visits only the routed
+// inputs. An input routed to a single output is written straight through.
+// For synthesis the call is ac_xbar.
+template<
+         int NUM_IN,
+         int NUM_OUT,
+         typename T >
+class ac_xbar_cached {
+public:
+  ac_xbar_cached() : valid(false), nsrc(0) {}
+
+  template<typename ...Args>
+  void operator()(ac_int<NUM_IN, false> sel_i[NUM_OUT], ac_channel<T> &chan, Args&...args) {
+#ifdef __SYNTHESIS__
+    ac_xbar<NUM_IN, NUM_OUT>(sel_i, chan, args...);
+#else
+    constexpr auto size_args = sizeof...(args);
+    static_assert((NUM_IN+NUM_OUT-1) == size_args, "Unexpected number of arguments");
+
+    if(!valid || changed(sel_i))
+      decode(sel_i);
+
+    ac_channel<T> *bank[NUM_IN+NUM_OUT] = { &chan, &args... };
+    for(int s = 0; s < nsrc; ++s) {
+      const int j = src[s];
+      if(!bank[j]->available(1))
+        continue;
+      if(fanout[j] == 1) {
+        bank[dst[j][0]]->write(bank[j]->read());
+      } else {
+        const T data = bank[j]->read();
+        for(int k = 0; k < fanout[j]; ++k)
+          bank[dst[j][k]]->write(data);
+      }
+    }
+#endif
+  }
+
+private:
+  bool changed(const ac_int<NUM_IN, false> sel_i[NUM_OUT]) const {
+    for(int i = 0; i < NUM_OUT; ++i)
+      if(sel[i] != sel_i[i])
+        return true;
+    return false;
+  }
+
+  void decode(const ac_int<NUM_IN, false> sel_i[NUM_OUT]) {
+    for(int j = 0; j < NUM_IN; ++j)
+      fanout[j] = 0;
+    for(int i = 0; i < NUM_OUT; ++i) {
+      const auto &s = sel_i[i];
+      if(s & (s-1)) {
+        std::stringstream ss;
+        ss<<"sel_i["<<i<<"]="<<s.to_string(AC_HEX, false, true)<<" must be one-hot or zero ";
+        AC_ASSERT(false, ss.str().c_str());
+      }
+      sel[i] = s;
+      if(s == 0)
+        continue;
+      for(int j = 0; j < NUM_IN; ++j) {
+        if(s[j]) {
+          dst[j][fanout[j]++] = i + NUM_IN;
+          break;
+        }
+      }
+    }
+    nsrc = 0;
+    for(int j = 0; j < NUM_IN; ++j)
+      if(fanout[j])
+        src[nsrc++] = j;
+    valid = true;
+  }
+
+  ac_int<NUM_IN, false> sel[NUM_OUT];  // selections the table was built for
+  bool valid;
+  int nsrc;                            // routed inputs: src[0..nsrc-1]
+  int src[NUM_IN];
+  int fanout[NUM_IN];                  // outputs of input j: dst[j][0..fanout[j]-1]
+  int dst[NUM_IN][NUM_OUT];
+};